@@ -18,6 +18,7 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Portability.hpp"
+#include "Lib/Random.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/System.hpp"
 #include "Lib/ScopedLet.hpp"
@@ -26,6 +27,7 @@
 #include "Lib/Sys/Multiprocessing.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/Preprocess.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "Shell/Normalisation.hpp"
@@ -34,6 +36,9 @@
 
 #include <unistd.h>
 #include <signal.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <fstream>
 #include <cstdio>
 #include <random>
@@ -41,6 +46,7 @@
 //only for detecting number of cores, no threading here!
 #include <thread>
 
+#include "Saturation/ClauseExchange.hpp"
 #include "Saturation/ProvingHelper.hpp"
 
 #include "Kernel/Problem.hpp"
@@ -57,7 +63,7 @@ using std::cerr;
 using std::endl;
 namespace fs = std::filesystem;
 
-PortfolioMode::PortfolioMode(Problem* problem) : _prb(problem), _slowness(env.options->slowness()) {
+PortfolioMode::PortfolioMode(Problem* problem) : _useZygotes(false), _preprocessed(false), _parent(getpid()), _heartbeats{-1, -1}, _prb(problem), _slowness(env.options->slowness()) {
   unsigned cores = std::thread::hardware_concurrency();
   cores = cores < 1 ? 1 : cores;
   _numWorkers = std::min(cores, env.options->multicore());
@@ -435,41 +441,184 @@ void PortfolioMode::getSchedules(const Property& prop, Schedule& quick, Schedule
 bool PortfolioMode::runSchedule(Schedule schedule) {
   TIME_TRACE("run schedule");
 
+  // slices started from a zygote must end up as our children
+  _useZygotes = env.options->portfolioZygotes() && Multiprocessing::instance()->becomeSubreaper();
+
+  // the slices inherit the buffer and our signature
+  if (env.options->portfolioClauseExchange() && !_prb->isHigherOrder() && !_prb->hasPolymorphicSym()) {
+    Saturation::ClauseExchange::create();
+  }
+
+  // neither side may ever block on the heartbeat pipe
+  if (env.options->portfolioPreemption() && _heartbeats[0] == -1 && pipe(_heartbeats) == 0) {
+    fcntl(_heartbeats[0], F_SETFL, O_NONBLOCK);
+    fcntl(_heartbeats[1], F_SETFL, O_NONBLOCK);
+  }
+  bool preemption = _heartbeats[0] != -1;
+
   Schedule::BottomFirstIterator it(schedule);
-  Set<pid_t> processes;
+  // running processes and their position in the (current copy of the) schedule
+  DHMap<pid_t,unsigned> processes;
+  // with portfolio_preemption, what the running processes have achieved
+  DHMap<pid_t,Progress> progress;
+  // position of the next slice to run in the schedule
+  unsigned nextSlice = 0;
+
+  // with portfolio_suspend, slices which reached their limit and were stopped,
+  // indexed by their position in the schedule, and the memory they occupy
+  DHMap<unsigned,pid_t> frozen;
+  DHMap<pid_t,size_t> frozenMemory;
+  size_t totalFrozenMemory = 0;
+  size_t frozenMemoryLimit = size_t(env.options->portfolioSuspendMemory()) * 1048576ul;
+
+  // with portfolio_memory_budget, the memory all the slices together may occupy
+  size_t memoryBudget = size_t(env.options->portfolioMemoryBudget()) * 1048576ul;
+  size_t runningMemory = 0;
+  // the part of runningMemory occupied by zygotes
+  size_t zygoteMemory = 0;
+  // we cannot just wait for a child to change state if we also need to watch the children
+  bool polling = preemption || memoryBudget;
+
   bool success = false;
   int remainingTime;
   while(remainingTime = env.remainingTime() / 100, remainingTime > 0)
   {
     // running under capacity, wake up more tasks
-    while(processes.size() < _numWorkers)
+    // (unless we expect the next slice to break the memory budget)
+    while(processes.size() + _pendingSlices.size() < _numWorkers && (!memoryBudget || processes.isEmpty() ||
+          runningMemory + totalFrozenMemory + (runningMemory - zygoteMemory) / processes.size() <= memoryBudget))
     {
       // after exhaustion we replace the schedule
       // by copies with x2 time limits and do this forever
       if(!it.hasNext()) {
         Schedule next;
-        rescaleScheduleLimits(schedule, next, 2.0);
+        rescaleScheduleLimits(schedule, next, RESCALE_LIMIT_MULTIPLIER);
         schedule = next;
         it = Schedule::BottomFirstIterator(schedule);
+        nextSlice = 0;
       }
       ALWAYS(it.hasNext());
 
       std::string code = it.next();
-      pid_t process = Multiprocessing::instance()->fork();
-      ASS_NEQ(process, -1);
-      if(process == 0)
-      {
-        TIME_TRACE_NEW_ROOT("child process")
-        runSlice(code, remainingTime);
-        ASSERTION_VIOLATION; // should not return
+      unsigned slice = nextSlice++;
+
+      pid_t process;
+      if(frozen.pop(slice, process)) {
+        // the slice already did the work of the previous copy, let it go on with its extended limit
+        size_t memory;
+        ALWAYS(frozenMemory.pop(process, memory));
+        totalFrozenMemory -= memory;
+        Multiprocessing::instance()->kill(process, SIGCONT);
+      }
+      else {
+        process = startSlice(code, slice, remainingTime);
+        if(!process) {
+          // requested from a zygote, see receiveSlicesFromZygotes
+          continue;
+        }
       }
-      ALWAYS(processes.insert(process));
+      ALWAYS(processes.insert(process, slice));
     }
 
-    bool exited, signalled;
+    bool exited, signalled, stopped;
     int code;
+    if(preemption) {
+      // listen to the slices for a while, then look at their state without blocking
+      if(receiveHeartbeats(processes, progress)) {
+        success = true;
+        break;
+      }
+    }
+    // we cannot block on the children either while zygotes are to tell us about the slices they start
+    bool waiting = polling || _pendingSlices.isNonEmpty();
+    if(waiting) {
+      // (without anything to listen to, this just waits)
+      receiveSlicesFromZygotes(processes, remainingTime, preemption ? 0 : WAIT_MS);
+    }
+
+    if(memoryBudget) {
+      // the slice to stop first: the one occupying the most memory for the fewest recent activations
+      pid_t costliest = 0;
+      size_t costliestMemory = 0;
+      float highestCost = -1;
+      runningMemory = 0;
+      decltype(processes)::Iterator pit(processes);
+      while(pit.hasNext()) {
+        pid_t running = pit.nextKey();
+        size_t memory = Multiprocessing::instance()->proportionalMemory(running);
+        runningMemory += memory;
+
+        // without portfolio_preemption, we only know about the memory
+        unsigned activations = 0;
+        if(Progress* recorded = progress.findPtr(running)) {
+          activations = recorded->windowActivations + recorded->lastActivations - recorded->heartbeat.activations;
+        }
+        float cost = float(memory) / (1 + activations);
+        if(cost > highestCost) {
+          costliest = running;
+          costliestMemory = memory;
+          highestCost = cost;
+        }
+      }
+      // the zygotes hold on to their preprocessed problems as long as we run
+      // (shared with the slices they started, which is why all the sizes are proportional ones)
+      zygoteMemory = 0;
+      decltype(_zygotes)::Iterator zit(_zygotes);
+      while(zit.hasNext()) {
+        const Zygote& zygote = zit.next();
+        if(zygote.socket != -1) {
+          zygoteMemory += Multiprocessing::instance()->proportionalMemory(zygote.pid);
+        }
+      }
+      runningMemory += zygoteMemory;
+
+      if(runningMemory + totalFrozenMemory > memoryBudget) {
+        // frozen slices make no progress at all, so they go first
+        decltype(frozenMemory)::Iterator fit(frozenMemory);
+        pid_t victim = 0;
+        size_t victimMemory = 0;
+        while(fit.hasNext()) {
+          pid_t candidate;
+          size_t memory;
+          fit.next(candidate, memory);
+          if(memory >= victimMemory) {
+            victim = candidate;
+            victimMemory = memory;
+          }
+        }
+
+        if(victim) {
+          Multiprocessing::instance()->killAndReap(victim);
+          ALWAYS(frozenMemory.remove(victim));
+          totalFrozenMemory -= victimMemory;
+          DHMap<unsigned,pid_t>::DelIterator dit(frozen);
+          while(dit.hasNext()) {
+            if(dit.next() == victim) {
+              dit.del();
+            }
+          }
+        }
+        // a single slice is only bound by its memory_limit
+        else if(processes.size() > 1) {
+          ALWAYS(processes.remove(costliest));
+          progress.remove(costliest);
+          if(!Multiprocessing::instance()->killAndReap(costliest)) {
+            // it was done already
+            success = true;
+            break;
+          }
+          runningMemory -= costliestMemory;
+          Shell::addCommentSignForSZS(cout);
+          cout << "Child " << costliest << " stopped to stay within the memory budget" << endl;
+        }
+      }
+    }
+
     // sleep until process changes state
-    pid_t process = Multiprocessing::instance()->poll_children(exited, signalled, code);
+    pid_t process = Multiprocessing::instance()->poll_children(exited, signalled, stopped, code, !waiting);
+    if(!process) {
+      continue;
+    }
 
     /*
     cout << "Child " << process
@@ -477,6 +626,30 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
         << " sig " << signalled << " code " << code << endl;
         */
 
+    // zygotes exit when we stop talking to them, or when they failed to preprocess
+    if(!processes.find(process) && !frozenMemory.find(process)) {
+      // but this could also be a slice done before we heard about it (its pid is sent before it starts)
+      receiveSlicesFromZygotes(processes, remainingTime, 0);
+      if(!processes.find(process)) {
+        continue;
+      }
+    }
+    // a slice coming back from being frozen starts measuring its progress afresh
+    progress.remove(process);
+
+    // a frozen slice should only change state when killed from outside
+    size_t memory;
+    if((exited || signalled) && frozenMemory.pop(process, memory)) {
+      totalFrozenMemory -= memory;
+      DHMap<unsigned,pid_t>::DelIterator fit(frozen);
+      while(fit.hasNext()) {
+        if(fit.next() == process) {
+          fit.del();
+        }
+      }
+      continue;
+    }
+
     // child died, remove it from the pool and check if succeeded
     if(exited)
     {
@@ -491,17 +664,367 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
       Shell::addCommentSignForSZS(cout);
       cout<<"Child killed by signal " << code << endl;
       ALWAYS(processes.remove(process));
+    } else if (stopped && env.options->portfolioSuspend()) {
+      // the slice reached its limit (cf. Timer::suspendOnLimit): freeze it if there is memory to spare
+      unsigned slice;
+      ALWAYS(processes.pop(process, slice));
+      memory = Multiprocessing::instance()->proportionalMemory(process);
+      if(!frozenMemoryLimit || totalFrozenMemory + memory <= frozenMemoryLimit) {
+        ALWAYS(frozen.insert(slice, process));
+        ALWAYS(frozenMemory.insert(process, memory));
+        totalFrozenMemory += memory;
+      }
+      else {
+        Multiprocessing::instance()->killAndReap(process);
+      }
     }
   }
 
   // kill all running processes first
   decltype(processes)::Iterator killIt(processes);
   while(killIt.hasNext())
-    Multiprocessing::instance()->killNoCheck(killIt.next(), SIGINT);
+    Multiprocessing::instance()->killNoCheck(killIt.nextKey(), SIGINT);
+  // stopped processes would not handle SIGINT
+  decltype(frozen)::Iterator frozenIt(frozen);
+  while(frozenIt.hasNext())
+    Multiprocessing::instance()->killNoCheck(frozenIt.next(), SIGKILL);
+  decltype(_zygotes)::Iterator zygoteIt(_zygotes);
+  while(zygoteIt.hasNext())
+    Multiprocessing::instance()->killNoCheck(zygoteIt.next().pid, SIGKILL);
+  _pendingSlices.reset();
 
   return success;
 }
 
+/**
+ * Wait a moment for heartbeats of the slices and terminate those which
+ * are stuck according to them, removing them from @b processes.
+ * Return true if one of them succeeded before it could be terminated.
+ *
+ * A slice is stuck if it has started saturation but neither activated, retained nor generated
+ * a clause over IDLE_WINDOWS portfolio_preemption_windows in a row (the first starting with
+ * the heartbeat recorded in @b progress), or if it is about to run out of memory
+ * with its passive set still growing over a single window.
+ */
+bool PortfolioMode::receiveHeartbeats(DHMap<pid_t,unsigned>& processes, DHMap<pid_t,Progress>& progress)
+{
+  pollfd fd = { _heartbeats[0], POLLIN, 0 };
+  if(poll(&fd, 1, WAIT_MS) <= 0) {
+    return false;
+  }
+
+  long window = long(env.options->portfolioPreemptionWindow()) * 100;
+  size_t memoryLimit = size_t(env.options->memoryLimit()) * 1048576ul;
+
+  Timer::Heartbeat heartbeats[64];
+  ssize_t size;
+  // writes are atomic and of the same size, so we never read part of a heartbeat
+  while((size = read(_heartbeats[0], heartbeats, sizeof(heartbeats))) > 0) {
+    long now = Timer::elapsedMilliseconds();
+    for(unsigned i = 0; i < size / sizeof(Timer::Heartbeat); i++) {
+      const Timer::Heartbeat& current = heartbeats[i];
+      if(!processes.find(current.pid)) {
+        // already gone
+        continue;
+      }
+      Progress* recorded = progress.findPtr(current.pid);
+      if(!recorded) {
+        progress.insert(current.pid, { current, now, 0, 0, current.activations });
+        continue;
+      }
+      recorded->lastActivations = current.activations;
+      if(now - recorded->time < window) {
+        continue;
+      }
+
+      const Timer::Heartbeat& previous = recorded->heartbeat;
+      bool idle = previous.activations && current.activations == previous.activations &&
+        current.retained == previous.retained && current.generated == previous.generated;
+      bool exploding = memoryLimit && current.memory >= memoryLimit / 4 * 3 &&
+        current.retained - previous.retained > current.activations - previous.activations;
+      if(!exploding && (!idle || recorded->idleWindows + 1 < IDLE_WINDOWS)) {
+        *recorded = { current, now, idle ? recorded->idleWindows + 1 : 0,
+          current.activations - previous.activations, current.activations };
+        continue;
+      }
+
+      ALWAYS(processes.remove(current.pid));
+      progress.remove(current.pid);
+      if(!Multiprocessing::instance()->killAndReap(current.pid)) {
+        // it was done already
+        return true;
+      }
+      Shell::addCommentSignForSZS(cout);
+      cout << "Child " << current.pid << " preempted as " << (exploding ? "running out of memory" : "idle") << endl;
+    }
+  }
+  return false;
+}
+
+/**
+ * Start a child process running the slice given by @b sliceCode and return its pid.
+ * Return 0 if the slice was requested from a zygote instead, see receiveSlicesFromZygotes.
+ */
+pid_t PortfolioMode::startSlice(std::string sliceCode, unsigned slice, int remainingTime)
+{
+  if(_useZygotes && requestSliceFromZygote(sliceCode, slice, remainingTime)) {
+    return 0;
+  }
+
+  pid_t process = Multiprocessing::instance()->fork();
+  ASS_NEQ(process, -1);
+  if(process == 0)
+  {
+    TIME_TRACE_NEW_ROOT("child process")
+    runSlice(sliceCode, remainingTime);
+    ASSERTION_VIOLATION; // should not return
+  }
+  return process;
+}
+
+// transfer exactly @b size bytes over @b socket, false if the other side is gone
+static bool sendAll(int socket, const void* data, size_t size)
+{
+  const char* bytes = static_cast<const char*>(data);
+  while(size) {
+    ssize_t sent = send(socket, bytes, size, MSG_NOSIGNAL);
+    if(sent <= 0) {
+      if(sent == -1 && errno == EINTR) continue;
+      return false;
+    }
+    bytes += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+static bool receiveAll(int socket, void* data, size_t size)
+{
+  char* bytes = static_cast<char*>(data);
+  while(size) {
+    ssize_t received = recv(socket, bytes, size, 0);
+    if(received <= 0) {
+      if(received == -1 && errno == EINTR) continue;
+      return false;
+    }
+    bytes += received;
+    size -= received;
+  }
+  return true;
+}
+
+/**
+ * Ask the zygote responsible for the preprocessing fingerprint of @b sliceCode
+ * (starting it first if there is none) to start the slice at position @b slice of the schedule.
+ * The zygote tells us the slice's pid when it is done preprocessing, see receiveSlicesFromZygotes.
+ * Return false if the slice has to be started the usual way instead.
+ */
+bool PortfolioMode::requestSliceFromZygote(std::string sliceCode, unsigned slice, int remainingTime)
+{
+  std::string fingerprint;
+  try {
+    Options opt = *env.options;
+    opt.readFromEncodedOptions(sliceCode);
+    opt.setForcedOptionValues();
+    fingerprint = opt.preprocessingFingerprint();
+  }
+  catch(Exception&) {
+    // leave the complaining to the slice itself
+    return false;
+  }
+  if(fingerprint.empty()) {
+    return false;
+  }
+
+  Zygote zygote;
+  if(!_zygotes.find(fingerprint, zygote)) {
+    int sockets[2];
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+      zygote = { -1, -1 };
+    }
+    else {
+      zygote.pid = Multiprocessing::instance()->fork();
+      if(zygote.pid == 0) {
+        close(sockets[0]);
+        TIME_TRACE_NEW_ROOT("zygote process")
+        runZygote(sliceCode, sockets[1]);
+      }
+      close(sockets[1]);
+      zygote.socket = sockets[0];
+    }
+    ALWAYS(_zygotes.insert(fingerprint, zygote));
+  }
+  if(zygote.socket == -1) {
+    return false;
+  }
+
+  unsigned length = sliceCode.size();
+  if(sendAll(zygote.socket, &remainingTime, sizeof(remainingTime)) &&
+     sendAll(zygote.socket, &length, sizeof(length)) &&
+     sendAll(zygote.socket, sliceCode.data(), length)) {
+    _pendingSlices.push({ fingerprint, zygote.socket, slice, sliceCode });
+    return true;
+  }
+  zygoteFailed(fingerprint);
+  return false;
+}
+
+/**
+ * Wait up to @b timeout milliseconds for the zygotes to tell us the pids of the slices
+ * requested from them and add the slices to @b processes. The slices of zygotes which failed
+ * are started the usual way instead, with at most @b remainingTime deciseconds.
+ */
+void PortfolioMode::receiveSlicesFromZygotes(DHMap<pid_t,unsigned>& processes, int remainingTime, int timeout)
+{
+  Stack<pollfd> fds;
+  for(const PendingSlice& pending : _pendingSlices) {
+    bool listening = pending.socket == -1;
+    for(const pollfd& fd : fds) {
+      listening |= fd.fd == pending.socket;
+    }
+    if(!listening) {
+      fds.push({ pending.socket, POLLIN, 0 });
+    }
+  }
+
+  if(poll(fds.begin(), fds.size(), timeout) > 0) {
+    for(const pollfd& fd : fds) {
+      if(!fd.revents) {
+        continue;
+      }
+      unsigned index = 0;
+      while(_pendingSlices[index].socket != fd.fd) {
+        index++;
+      }
+      // the oldest request to the zygote is the one answered
+      PendingSlice pending = popPendingSlice(index);
+
+      // the pid is sent at once, so waiting for the rest of it takes no time
+      pid_t process;
+      if(receiveAll(fd.fd, &process, sizeof(process)) && process > 0) {
+        ALWAYS(processes.insert(process, pending.slice));
+        continue;
+      }
+      zygoteFailed(pending.fingerprint);
+      pending.socket = -1;
+      _pendingSlices.push(pending);
+    }
+  }
+
+  for(unsigned index = 0; index < _pendingSlices.size();) {
+    if(_pendingSlices[index].socket != -1) {
+      index++;
+      continue;
+    }
+    PendingSlice pending = popPendingSlice(index);
+    pid_t process = startSlice(pending.code, pending.slice, remainingTime);
+    ASS_G(process, 0);
+    ALWAYS(processes.insert(process, pending.slice));
+  }
+}
+
+// remove the pending slice at @b index, keeping the others in order
+PortfolioMode::PendingSlice PortfolioMode::popPendingSlice(unsigned index)
+{
+  for(; index + 1 < _pendingSlices.size(); index++) {
+    std::swap(_pendingSlices[index], _pendingSlices[index + 1]);
+  }
+  return _pendingSlices.pop();
+}
+
+/**
+ * Stop talking to the zygote for @b fingerprint, which does not answer anymore.
+ * Its slices will preprocess by themselves, including those requested but not started yet.
+ */
+void PortfolioMode::zygoteFailed(const std::string& fingerprint)
+{
+  Zygote* zygote = _zygotes.findPtr(fingerprint);
+  ASS(zygote && zygote->socket != -1);
+  for(PendingSlice& pending : _pendingSlices) {
+    if(pending.socket == zygote->socket) {
+      pending.socket = -1;
+    }
+  }
+  close(zygote->socket);
+  zygote->socket = -1;
+}
+
+/**
+ * Preprocess @b prb as the slice @b sliceCode would, to start slices with the same
+ * preprocessing fingerprint from (see runZygote). Afterwards env.options are as before,
+ * so the slices build their options from the ones the portfolio was started with.
+ */
+void PortfolioMode::preprocessForSlices(Problem& prb, const std::string& sliceCode)
+{
+  Options opt = *env.options;
+  opt.readFromEncodedOptions(sliceCode);
+  opt.setNormalize(false);
+  opt.setForcedOptionValues();
+  opt.checkGlobalOptionConstraints();
+  ScopedLet<Options> sliceOpt(*env.options, opt);
+
+  Lib::Random::setSeed(opt.randomSeed());
+
+  TIME_TRACE(TimeTrace::PREPROCESSING);
+  Preprocess prepro(opt);
+  prepro.preprocess(prb);
+}
+
+/**
+ * Preprocess the problem according to the slice @b sliceCode
+ * and then serve the requests for starting slices coming over @b socket.
+ */
+void PortfolioMode::runZygote(std::string sliceCode, int socket)
+{
+  System::registerForSIGHUPOnParentDeath();
+  UIHelper::portfolioParent = false;
+
+  try {
+    preprocessForSlices(*_prb, sliceCode);
+  }
+  catch(Exception&) {
+    // the parent will notice we are gone
+    System::terminateImmediately(1);
+  }
+  _preprocessed = true;
+
+  int remainingTime;
+  unsigned length;
+  while(receiveAll(socket, &remainingTime, sizeof(remainingTime)) &&
+        receiveAll(socket, &length, sizeof(length))) {
+    std::string code(length, ' ');
+    if(!receiveAll(socket, code.data(), length)) {
+      break;
+    }
+
+    // the slice must be a child of the portfolio parent rather than ours:
+    // it is started from an intermediate process which exits straight away,
+    // leaving the slice to be adopted by the parent (the subreaper)
+    pid_t intermediate = Multiprocessing::instance()->fork();
+    if(intermediate == 0) {
+      intermediate = getpid();
+      pid_t process = Multiprocessing::instance()->fork();
+      if(process == 0) {
+        close(socket);
+        while(getppid() == intermediate) {
+          std::this_thread::yield();
+        }
+        if(getppid() != _parent) {
+          // nobody to report to
+          System::terminateImmediately(1);
+        }
+        runSlice(code, remainingTime);
+      }
+      sendAll(socket, &process, sizeof(process));
+      System::terminateImmediately(0);
+    }
+    int status;
+    Multiprocessing::instance()->waitForChildTermination(status);
+  }
+
+  System::terminateImmediately(0);
+}
+
 /**
  * Run a schedule.
  * Return true if a proof was found, otherwise return false.
@@ -580,6 +1103,30 @@ unsigned PortfolioMode::getSliceTime(const std::string &sliceCode)
   return _slowness * sliceTime;
 } // getSliceTime
 
+/**
+ * The options for running the slice @b sliceCode for @b sliceTime deciseconds,
+ * built from the options @b base the portfolio was started with.
+ */
+Options PortfolioMode::sliceOptions(const Options& base, const std::string& sliceCode, int sliceTime, float slowness)
+{
+  Options opt = base;
+
+  // opt.randomSeed() would normally be inherited from the parent
+  // addCommentSignForSZS(cout) << "runSlice - seed before setting: " << opt.randomSeed() << endl;
+  if (base.randomizeSeedForPortfolioWorkers()) {
+    // but here we want each worker to have their own seed
+    opt.setRandomSeed(std::random_device()());
+    // ... unless a strategy sets a seed explicitly, just below
+  }
+  opt.readFromEncodedOptions(sliceCode);
+  opt.setTimeLimitInDeciseconds(sliceTime);
+  int stl = opt.simulatedTimeLimit();
+  if (stl) {
+    opt.setSimulatedTimeLimit(int(stl * slowness));
+  }
+  return opt;
+}
+
 /**
  * Run a slice given by its code using the specified time limit.
  */
@@ -597,21 +1144,7 @@ void PortfolioMode::runSlice(std::string sliceCode, int timeLimitInDeciseconds)
   ASS_GE(sliceTime,0);
   try
   {
-    Options opt = *env.options;
-
-    // opt.randomSeed() would normally be inherited from the parent
-    // addCommentSignForSZS(cout) << "runSlice - seed before setting: " << opt.randomSeed() << endl;    
-    if (env.options->randomizeSeedForPortfolioWorkers()) {
-      // but here we want each worker to have their own seed
-      opt.setRandomSeed(std::random_device()());
-      // ... unless a strategy sets a seed explicitly, just below
-    }
-    opt.readFromEncodedOptions(sliceCode);
-    opt.setTimeLimitInDeciseconds(sliceTime);
-    int stl = opt.simulatedTimeLimit();
-    if (stl) {
-      opt.setSimulatedTimeLimit(int(stl * _slowness));
-    }
+    Options opt = sliceOptions(*env.options, sliceCode, sliceTime, _slowness);
     runSlice(opt);
   }
   catch(Exception &e)
@@ -649,9 +1182,22 @@ void PortfolioMode::runSlice(Options& strategyOpt)
       ")" << endl;
   }
 
+  if (opt.portfolioSuspend()) {
+    // wait for the parent to resume us with the limits of the next copy of the schedule
+    Timer::suspendOnLimit(RESCALE_LIMIT_MULTIPLIER);
+  }
+  if (_heartbeats[1] != -1) {
+    Timer::sendHeartbeats(_heartbeats[1]);
+  }
   Timer::reinitialise(); // timer only when done talking (otherwise output may get mangled)
 
-  Saturation::ProvingHelper::runVampire(*_prb, opt);
+  if (_preprocessed) {
+    // done by the zygote, cf. ProvingHelper::runVampire
+    Lib::Random::setSeed(opt.randomSeed());
+    Saturation::ProvingHelper::runVampireSaturation(*_prb, opt);
+  } else {
+    Saturation::ProvingHelper::runVampire(*_prb, opt);
+  }
 
   bool succeeded =
     env.statistics->terminationReason == Statistics::REFUTATION ||
@@ -19,8 +19,10 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
 #include "Lib/ScopedPtr.hpp"
 #include "Lib/Stack.hpp"
+#include "Lib/Timer.hpp"
 
 #include "Kernel/Problem.hpp"
 
@@ -41,6 +43,9 @@ public:
   static void rescaleScheduleLimits(const Schedule& sOld, Schedule& sNew, float limit_multiplier);
   static void addScheduleExtra(const Schedule& sOld, Schedule& sNew, std::string extra);
 
+  static Options sliceOptions(const Options& base, const std::string& sliceCode, int sliceTime, float slowness);
+  static void preprocessForSlices(Problem& prb, const std::string& sliceCode);
+
 private:
   // some of these names are kind of arbitrary and should be perhaps changed
   unsigned getSliceTime(const std::string &sliceCode);
@@ -50,13 +55,73 @@ private:
 
   bool runSchedule(Schedule schedule);
   bool runScheduleAndRecoverProof(Schedule schedule);
+  pid_t startSlice(std::string sliceCode, unsigned slice, int remainingTime);
+  bool requestSliceFromZygote(std::string sliceCode, unsigned slice, int remainingTime);
+  void receiveSlicesFromZygotes(DHMap<pid_t,unsigned>& processes, int remainingTime, int timeout);
+  void zygoteFailed(const std::string& fingerprint);
+  [[noreturn]] void runZygote(std::string sliceCode, int socket);
   [[noreturn]] void runSlice(std::string sliceCode, int remainingTime);
   [[noreturn]] void runSlice(Options& strategyOpt);
 
+  /**
+   * The last heartbeat of a slice against which its progress is measured
+   * (see portfolio_preemption), and when we received it.
+   */
+  struct Progress {
+    Timer::Heartbeat heartbeat;
+    long time;
+    // the windows in a row without progress before the one starting with heartbeat
+    unsigned idleWindows;
+    // activations in the previous window and as of the last heartbeat, for the memory budget
+    unsigned windowActivations;
+    unsigned lastActivations;
+  };
+  bool receiveHeartbeats(DHMap<pid_t,unsigned>& processes, DHMap<pid_t,Progress>& progress);
+
+  // limits of the schedule are multiplied by this each time it is exhausted
+  static constexpr float RESCALE_LIMIT_MULTIPLIER = 2.0;
+  // a slice is preempted as idle only after this many windows in a row without progress
+  static constexpr unsigned IDLE_WINDOWS = 3;
+  // milliseconds to wait for the slices and zygotes at a time while watching them
+  static constexpr int WAIT_MS = 100;
+
 #if VDEBUG
   DHSet<pid_t> childIds;
 #endif
   unsigned _numWorkers;
+
+  /**
+   * A process holding the problem preprocessed under one Options::preprocessingFingerprint(),
+   * from which the slices sharing the fingerprint are started (see portfolio_zygotes).
+   */
+  struct Zygote {
+    pid_t pid;
+    // our end of the socket through which slices are requested, -1 if the zygote failed
+    int socket;
+  };
+  DHMap<std::string, Zygote> _zygotes;
+  /**
+   * A slice requested from a zygote which has not told us the slice's pid yet.
+   * Zygotes answer the requests in the order they were sent.
+   */
+  struct PendingSlice {
+    std::string fingerprint;
+    // the socket of the zygote, -1 if the zygote failed and the slice is to be started the usual way
+    int socket;
+    // the position of the slice in the schedule
+    unsigned slice;
+    std::string code;
+  };
+  Stack<PendingSlice> _pendingSlices;
+  PendingSlice popPendingSlice(unsigned index);
+  bool _useZygotes;
+  // whether _prb has already been preprocessed (in a zygote)
+  bool _preprocessed;
+  // the portfolio parent process
+  pid_t _parent;
+  // the pipe over which the slices report their progress, -1 if they do not
+  int _heartbeats[2];
+
   // file that will contain a proof
   std::filesystem::path _path;
 
@@ -45,6 +45,7 @@ template <typename Key, typename Val, class Hash1=DefaultHash, class Hash2=Defau
 template <typename Val, class Hash1=DefaultHash, class Hash2=DefaultHash2> class DHSet;
 template <typename Val, class Hash1=DefaultHash, class Hash2=DefaultHash2> class DHMultiset;
 template <typename Val, class Hash=DefaultHash> class Set;
+template <typename Val, class Hash=DefaultHash> class TaggedSet;
 };
 
 namespace Kernel
@@ -55,6 +56,7 @@ class Signature;
 
 class Term;
 class TermList;
+class FlatTerm;
 typedef VirtualIterator<TermList> TermIterator;
 typedef Stack<TermList> TermStack;
 
@@ -156,6 +158,8 @@ class ClauseContainer;
 class UnprocessedClauseContainer;
 class PassiveClauseContainer;
 class ActiveClauseContainer;
+
+class ClauseExchange;
 }
 
 namespace Inferences
@@ -642,6 +642,28 @@ void CodeTree::visitAllOps(Visitor visitor) const
   }
 }
 
+/**
+ * Mark the ground terms the code checks, including those of removed entries
+ * that are still in the code, and the terms of the data, cf. TermSharing::collect()
+ */
+void CodeTree::markTerms() const
+{
+  visitAllOps([this](const CodeOp* op, unsigned depth) {
+    if (op->isCheckGroundTerm()) {
+      env.sharing->mark(op->getTargetTerm());
+    } else if (op->isSearchStruct()) {
+      auto ss = op->getSearchStruct();
+      if (ss->kind == SearchStruct::GROUND_TERM_STRUCT) {
+        for (Term* t : static_cast<const GroundTermSearchStruct*>(ss)->values) {
+          env.sharing->mark(t);
+        }
+      }
+    } else if (op->isSuccess()) {
+      markSuccessResult(op);
+    }
+  });
+}
+
 std::ostream& operator<<(std::ostream& out, const CodeTree& ct)
 {
   ct.visitAllOps([&out](const CodeTree::CodeOp* op, unsigned depth) {
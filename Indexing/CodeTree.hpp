@@ -42,6 +42,7 @@ using namespace Lib;
 using namespace Kernel;
 
 class CodeTree
+  : public TermRoot
 {
 public:
   struct ILStruct;
@@ -58,9 +59,14 @@ protected:
   */
   void (*_onCodeOpDestroying)(CodeOp* op);
       
+  /** Mark the terms of the data of a success operation, cf. markTerms() */
+  virtual void markSuccessResult(const CodeOp* op) const {}
+
 public:
   CodeTree();
   ~CodeTree();
+
+  void markTerms() const override;
   
   struct LitInfo
   {
@@ -202,7 +208,7 @@ public:
       return _data<Term>();
     }
 
-    template<class T> inline T* getSuccessResult() { ASS(isSuccess()); return _data<T>(); }
+    template<class T> inline T* getSuccessResult() const { ASS(isSuccess()); return _data<T>(); }
 
     inline ILStruct* getILS() { ASS(isLitEnd()); return _data<ILStruct>(); }
     inline const ILStruct* getILS() const { return _data<ILStruct>(); }
@@ -0,0 +1,213 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FeatureVectorIndex.cpp
+ * Implements class FeatureVectorIndex.
+ */
+
+#include "Debug/TimeProfiling.hpp"
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+#include "Lib/Recycled.hpp"
+
+#include "FeatureVectorIndex.hpp"
+
+namespace Indexing {
+
+using namespace std;
+
+FeatureVectorIndex::Node::~Node()
+{
+  for (auto& child : children) {
+    delete child.second;
+  }
+}
+
+FeatureVectorIndex::~FeatureVectorIndex()
+{
+}
+
+/**
+ * Compute the features of @b cl into @b res, laid out as the numbers of
+ * positive and negative literals, followed for the positive and then the
+ * negative literals by the occurrence counts and maximal depths per bucket.
+ *
+ * Variables and special terms do not contribute, so that instantiating
+ * a clause can only increase its features.
+ */
+void FeatureVectorIndex::computeFeatures(Clause* cl, FeatureVector& res)
+{
+  res.fill(0);
+
+  Recycled<Stack<pair<Term*,unsigned>>> todo;
+  unsigned clen = cl->length();
+  for (unsigned i = 0; i < clen; i++) {
+    Literal* lit = (*cl)[i];
+    unsigned pol = lit->isPositive() ? 0 : 1;
+    res[pol]++;
+    unsigned* counts = res.data() + 2 + 2 * pol * SYMBOL_BUCKETS;
+    unsigned* depths = counts + SYMBOL_BUCKETS;
+
+    counts[lit->functor() % SYMBOL_BUCKETS]++;
+    todo->push(make_pair(lit, 0u));
+    while (todo->isNonEmpty()) {
+      auto [t, depth] = todo->pop();
+      for (TermList* arg = t->args(); arg->isNonEmpty(); arg = arg->next()) {
+        if (!arg->isTerm() || arg->term()->isSpecial()) {
+          continue;
+        }
+        Term* s = arg->term();
+        unsigned bucket = s->functor() % SYMBOL_BUCKETS;
+        counts[bucket]++;
+        depths[bucket] = max(depths[bucket], depth + 1);
+        if (s->arity()) {
+          todo->push(make_pair(s, depth + 1));
+        }
+      }
+    }
+  }
+}
+
+void FeatureVectorIndex::handleClause(Clause* c, bool adding)
+{
+  TIME_TRACE("feature vector index maintenance");
+
+  FeatureVector fv;
+  computeFeatures(c, fv);
+
+  if (!adding) {
+    ALWAYS(remove(&_root, 0, fv, c));
+    _size--;
+    return;
+  }
+
+  Node* node = &_root;
+  for (unsigned i = 0; i < FEATURES; i++) {
+    auto& children = node->children;
+    unsigned pos = 0;
+    while (pos < children.size() && children[pos].first < fv[i]) {
+      pos++;
+    }
+    if (pos == children.size() || children[pos].first != fv[i]) {
+      // keep the children ordered by value
+      children.push(make_pair(fv[i], new Node()));
+      for (unsigned j = children.size() - 1; j > pos; j--) {
+        swap(children[j], children[j - 1]);
+      }
+    }
+    node = children[pos].second;
+  }
+  node->clauses.push(c);
+  _size++;
+}
+
+/**
+ * Remove @b cl with feature vector @b fv from the subtrie at @b node,
+ * which is at the given depth, deleting the nodes that become empty.
+ * Return true if @b cl was found.
+ */
+bool FeatureVectorIndex::remove(Node* node, unsigned depth, const FeatureVector& fv, Clause* cl)
+{
+  if (depth == FEATURES) {
+    return node->clauses.remove(cl);
+  }
+  auto& children = node->children;
+  for (unsigned pos = 0; pos < children.size(); pos++) {
+    if (children[pos].first != fv[depth]) {
+      continue;
+    }
+    Node* child = children[pos].second;
+    if (!remove(child, depth + 1, fv, cl)) {
+      return false;
+    }
+    if (child->children.isEmpty() && child->clauses.isEmpty()) {
+      delete child;
+      for (unsigned j = pos + 1; j < children.size(); j++) {
+        children[j - 1] = children[j];
+      }
+      children.pop();
+    }
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Iterator over the clauses of the trie whose feature vectors are
+ * pointwise smaller or equal (if @b subsuming) or greater or equal
+ * (otherwise) than the query vector.
+ */
+template<bool subsuming>
+class FeatureVectorIndex::CandidateIterator
+{
+public:
+  DECL_ELEMENT_TYPE(Clause*);
+
+  CandidateIterator(Node* root, const FeatureVector& query)
+    : _query(query), _leaf(nullptr), _next(0)
+  {
+    _todo.push(make_pair(root, 0u));
+  }
+
+  bool hasNext()
+  {
+    while (!_leaf || _next == _leaf->clauses.size()) {
+      if (_todo.isEmpty()) {
+        return false;
+      }
+      auto [node, depth] = _todo.pop();
+      if (depth == FEATURES) {
+        _leaf = node;
+        _next = 0;
+        continue;
+      }
+      unsigned bound = _query[depth];
+      for (auto& child : node->children) {
+        if (subsuming ? child.first > bound : child.first < bound) {
+          if (subsuming) {
+            // children are ordered, so the rest are greater too
+            break;
+          }
+          continue;
+        }
+        _todo.push(make_pair(child.second, depth + 1));
+      }
+    }
+    return true;
+  }
+
+  Clause* next()
+  {
+    ASS(_leaf && _next < _leaf->clauses.size());
+    return _leaf->clauses[_next++];
+  }
+
+private:
+  FeatureVector _query;
+  Stack<pair<Node*,unsigned>> _todo;
+  Node* _leaf;
+  unsigned _next;
+};
+
+ClauseIterator FeatureVectorIndex::getSubsumingCandidates(Clause* cl)
+{
+  FeatureVector fv;
+  computeFeatures(cl, fv);
+  return pvi(CandidateIterator<true>(&_root, fv));
+}
+
+ClauseIterator FeatureVectorIndex::getSubsumedCandidates(Clause* cl)
+{
+  FeatureVector fv;
+  computeFeatures(cl, fv);
+  return pvi(CandidateIterator<false>(&_root, fv));
+}
+
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FeatureVectorIndex.hpp
+ * Defines class FeatureVectorIndex.
+ */
+
+#ifndef __FeatureVectorIndex__
+#define __FeatureVectorIndex__
+
+#include <array>
+
+#include "Forwards.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Index.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Clause-level index for subsumption candidates, in the style of the
+ * feature vector indexing of E (S. Schulz, "Simple and Efficient Clause
+ * Subsumption with Feature Vector Indexing", 2013).
+ *
+ * Every feature of a clause C is at most the same feature of any clause
+ * multiset-subsumed by C. The features are the numbers of positive and
+ * negative literals, and for each polarity and bucket of symbols the number
+ * of occurrences of those symbols and the greatest depth of an occurrence.
+ * Symbols are hashed into SYMBOL_BUCKETS buckets.
+ *
+ * The clauses are kept in a trie over their feature vectors, so candidates
+ * are retrieved by walking only the branches compatible with the query.
+ * Subsumption resolution does not preserve the features, so it still has
+ * to use the literal indices.
+ */
+class FeatureVectorIndex
+: public Index
+{
+public:
+  static constexpr unsigned SYMBOL_BUCKETS = 16;
+  static constexpr unsigned FEATURES = 2 + 4 * SYMBOL_BUCKETS;
+  typedef std::array<unsigned, FEATURES> FeatureVector;
+
+  ~FeatureVectorIndex() override;
+
+  static void computeFeatures(Clause* cl, FeatureVector& res);
+
+  /** Clauses that may subsume @b cl, i.e. none of whose features is greater */
+  ClauseIterator getSubsumingCandidates(Clause* cl);
+  /** Clauses that may be subsumed by @b cl, i.e. none of whose features is smaller */
+  ClauseIterator getSubsumedCandidates(Clause* cl);
+
+  unsigned size() const { return _size; }
+
+protected:
+  void handleClause(Clause* c, bool adding) override;
+
+private:
+  struct Node
+  {
+    ~Node();
+    /** Inner nodes: children ordered by the value of the next feature */
+    Stack<std::pair<unsigned,Node*>> children;
+    /** Leaves: clauses with the feature vector leading here */
+    Stack<Clause*> clauses;
+  };
+
+  template<bool subsuming>
+  class CandidateIterator;
+
+  static bool remove(Node* node, unsigned depth, const FeatureVector& fv, Clause* cl);
+
+  Node _root;
+  unsigned _size = 0;
+};
+
+};
+
+#endif /* __FeatureVectorIndex__ */
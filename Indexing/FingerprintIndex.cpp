@@ -0,0 +1,153 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FingerprintIndex.cpp
+ * Implements class Fingerprint.
+ */
+
+#include "Kernel/Term.hpp"
+#include "Lib/Hash.hpp"
+
+#include "FingerprintIndex.hpp"
+
+namespace Indexing {
+
+using namespace std;
+
+/** the sampled positions as argument indices, -1 marking the end of a shorter position */
+static const int POSITION_PATHS[Fingerprint::POSITIONS][2] = {
+  { -1, -1 }, { 0, -1 }, { 1, -1 }, { 2, -1 }, { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 },
+};
+
+Fingerprint::Fingerprint(TermList t)
+{
+  for (unsigned i = 0; i < POSITIONS; i++) {
+    TermList s = t;
+    unsigned value = 0;
+    bool done = false;
+    for (unsigned j = 0; !done && j < 2; j++) {
+      int arg = POSITION_PATHS[i][j];
+      if (arg < 0) {
+        break;
+      }
+      if (s.isVar()) {
+        value = BELOW_VAR;
+        done = true;
+      } else if (s.term()->isSpecial()) {
+        value = ANY;
+        done = true;
+      } else if ((unsigned)arg >= s.term()->arity()) {
+        value = NONE;
+        done = true;
+      } else {
+        s = *s.term()->nthArgument(arg);
+      }
+    }
+    if (!done) {
+      if (s.isVar()) {
+        value = VAR;
+      } else if (s.term()->isSpecial()) {
+        value = ANY;
+      } else {
+        value = FIRST_FUNCTOR + s.term()->functor();
+      }
+    }
+    _values[i] = value;
+  }
+}
+
+/**
+ * Compatibility of two positions under unification, following the table
+ * of Schulz's paper: a variable unifies with any symbol and with positions
+ * below a variable, but not with a missing position.
+ */
+bool Fingerprint::mayUnify(const Fingerprint& fp1, const Fingerprint& fp2)
+{
+  for (unsigned i = 0; i < POSITIONS; i++) {
+    unsigned v1 = fp1._values[i];
+    unsigned v2 = fp2._values[i];
+    if (v1 == v2 || v1 == ANY || v2 == ANY || v1 == BELOW_VAR || v2 == BELOW_VAR) {
+      continue;
+    }
+    if (v1 == NONE || v2 == NONE) {
+      return false;
+    }
+    if (v1 != VAR && v2 != VAR) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Compatibility of two positions under matching @b general onto
+ * @b instance. Unlike unification, a variable of the instance can only
+ * be matched by a variable.
+ */
+bool Fingerprint::mayGeneralize(const Fingerprint& general, const Fingerprint& instance)
+{
+  for (unsigned i = 0; i < POSITIONS; i++) {
+    unsigned g = general._values[i];
+    unsigned v = instance._values[i];
+    if (g == ANY || v == ANY || g == BELOW_VAR) {
+      continue;
+    }
+    switch (g) {
+      case VAR:
+        if (v == NONE || v == BELOW_VAR) {
+          return false;
+        }
+        break;
+      case NONE:
+        if (v != NONE && v != BELOW_VAR) {
+          return false;
+        }
+        break;
+      default:
+        if (v != g) {
+          return false;
+        }
+    }
+  }
+  return true;
+}
+
+unsigned Fingerprint::defaultHash() const
+{
+  unsigned res = FNV32_OFFSET_BASIS;
+  for (unsigned v : _values) {
+    res = HashUtils::combine(res, DefaultHash::hash(v));
+  }
+  return res;
+}
+
+unsigned Fingerprint::defaultHash2() const
+{
+  return HashUtils::combine(_values[0], _values[1]);
+}
+
+std::ostream& operator<<(std::ostream& out, const Fingerprint& self)
+{
+  out << "[";
+  for (unsigned i = 0; i < Fingerprint::POSITIONS; i++) {
+    unsigned v = self._values[i];
+    out << (i ? " " : "");
+    switch (v) {
+      case Fingerprint::VAR: out << "A"; break;
+      case Fingerprint::BELOW_VAR: out << "B"; break;
+      case Fingerprint::NONE: out << "N"; break;
+      case Fingerprint::ANY: out << "*"; break;
+      default: out << (v - Fingerprint::FIRST_FUNCTOR);
+    }
+  }
+  return out << "]";
+}
+
+}
@@ -0,0 +1,365 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FingerprintIndex.hpp
+ * Defines class FingerprintIndex.
+ */
+
+#ifndef __FingerprintIndex__
+#define __FingerprintIndex__
+
+#include <array>
+
+#include "Forwards.hpp"
+#include "Kernel/Matcher.hpp"
+#include "Kernel/RobSubstitution.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/TypedTermList.hpp"
+#include "Kernel/UnificationWithAbstraction.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Recycled.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Index.hpp"
+#include "SubstitutionTree.hpp"
+#include "TermIndexingStructure.hpp"
+#include "TermSharing.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * The symbols at a few fixed positions of a term, or what is known about
+ * those positions if there is no symbol. If two terms unify, or one
+ * matches the other, then so do their fingerprints at every position.
+ */
+struct Fingerprint
+{
+  /** the positions sampled are ε, 1, 2, 3, 1.1, 1.2, 2.1 and 2.2 */
+  static constexpr unsigned POSITIONS = 8;
+
+  /** a variable occurs at the position */
+  static constexpr unsigned VAR = 0;
+  /** the position is below a variable */
+  static constexpr unsigned BELOW_VAR = 1;
+  /** the position does not exist and is not below a variable */
+  static constexpr unsigned NONE = 2;
+  /** the position is not sampled, e.g. inside a special term */
+  static constexpr unsigned ANY = 3;
+  /** symbol f at the position is represented by FIRST_FUNCTOR + f */
+  static constexpr unsigned FIRST_FUNCTOR = 4;
+
+  Fingerprint() {}
+  explicit Fingerprint(TermList t);
+
+  /** False if the terms with fingerprints @b fp1 and @b fp2 cannot unify */
+  static bool mayUnify(const Fingerprint& fp1, const Fingerprint& fp2);
+  /** False if the term with fingerprint @b general cannot be matched onto the one with @b instance */
+  static bool mayGeneralize(const Fingerprint& general, const Fingerprint& instance);
+
+  bool operator==(const Fingerprint& o) const { return _values == o._values; }
+  bool operator!=(const Fingerprint& o) const { return !(*this == o); }
+  unsigned defaultHash() const;
+  unsigned defaultHash2() const;
+
+  friend std::ostream& operator<<(std::ostream& out, const Fingerprint& self);
+
+private:
+  std::array<unsigned, POSITIONS> _values;
+};
+
+/**
+ * A substitution binding the variables of one side of a retrieval to terms
+ * of the other side, as found by matching.
+ */
+class MatchingSubstitution
+: public ResultSubstitution
+{
+public:
+  typedef DHMap<unsigned,TermList,IdentityHash,DefaultHash> BindingMap;
+
+  USE_ALLOCATOR(MatchingSubstitution);
+
+  /** if @b resultBound, the bindings are of result variables, otherwise of query variables */
+  MatchingSubstitution(const BindingMap* bindings, bool resultBound)
+  : _bindings(bindings), _resultBound(resultBound) {}
+
+  TermList apply(unsigned var)
+  {
+    TermList res;
+    return _bindings->find(var, res) ? res : TermList::var(var);
+  }
+
+  TermList applyToBoundResult(unsigned v) override
+  { ASS(_resultBound); return apply(v); }
+  TermList applyToBoundResult(TermList t) override
+  { ASS(_resultBound); return SubstHelper::apply(t, *this); }
+  Literal* applyToBoundResult(Literal* lit) override
+  { ASS(_resultBound); return SubstHelper::apply(lit, *this); }
+  bool isIdentityOnQueryWhenResultBound() override { return _resultBound; }
+
+  TermList applyToBoundQuery(TermList t) override
+  { ASS(!_resultBound); return SubstHelper::apply(t, *this); }
+  bool isIdentityOnResultWhenQueryBound() override { return !_resultBound; }
+
+  void output(std::ostream& out) const final override
+  { out << "MatchingSubstitution(<output unimplemented>)"; }
+
+private:
+  const BindingMap* _bindings;
+  bool _resultBound;
+};
+
+/**
+ * Fingerprint indexing (S. Schulz, "Fingerprint Indexing for Paramodulation
+ * and Rewriting", IJCAR 2012).
+ *
+ * The distinct fingerprints of the indexed terms are kept in one flat array,
+ * and the data of the terms sharing a fingerprint in a stack at the same
+ * index of another array. Retrieval scans the fingerprints and checks the
+ * terms of the compatible ones, so insertion and removal only cost a hash
+ * table lookup and are independent of the shape of the other terms.
+ *
+ * With unification with abstraction, symbols need not agree for terms to
+ * unify, so the fingerprints are not used and every term is checked.
+ */
+template<class Data>
+class FingerprintIndex
+: public TermIndexingStructure<Data>
+, public TermRoot
+{
+public:
+  void handle(Data data, bool insert) final override
+  {
+    TypedTermList key = data.key();
+    Fingerprint fp(key);
+    if (insert) {
+      unsigned* pos;
+      if (_positions.getValuePtr(fp, pos, _fingerprints.size())) {
+        _fingerprints.push(fp);
+        _data.push(Stack<Data>());
+      }
+      _data[*pos].push(std::move(data));
+      return;
+    }
+
+    ASS(_positions.find(fp));
+    unsigned idx = _positions.get(fp);
+    auto& group = _data[idx];
+    for (unsigned i = 0; i < group.size(); i++) {
+      if (group[i] == data) {
+        group.swapRemove(i);
+        break;
+      }
+    }
+    if (group.isEmpty()) {
+      // move the last fingerprint into the place of the removed one
+      unsigned last = _fingerprints.size() - 1;
+      if (idx != last) {
+        _positions.set(_fingerprints[last], idx);
+        std::swap(_fingerprints[idx], _fingerprints[last]);
+        std::swap(_data[idx], _data[last]);
+      }
+      _positions.remove(fp);
+      _fingerprints.pop();
+      _data.pop();
+    }
+  }
+
+  VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getUnifications(TypedTermList t, bool retrieveSubstitutions) final override
+  { return pvi(ResultIterator<Unification>(this, t, retrieveSubstitutions, Unification())); }
+
+  VirtualIterator<QueryRes<AbstractingUnifier*, Data>> getUwa(TypedTermList t, Options::UnificationWithAbstraction uwa, bool fixedPointIteration) final override
+  { return pvi(ResultIterator<UnificationWithAbstraction>(this, t, true, UnificationWithAbstraction(AbstractionOracle(uwa), fixedPointIteration))); }
+
+  VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getGeneralizations(TypedTermList t, bool retrieveSubstitutions) final override
+  { return pvi(ResultIterator<Matching<true>>(this, t, retrieveSubstitutions, Matching<true>())); }
+
+  VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getInstances(TypedTermList t, bool retrieveSubstitutions) final override
+  { return pvi(ResultIterator<Matching<false>>(this, t, retrieveSubstitutions, Matching<false>())); }
+
+  /** Each fingerprint is a node holding the entries with that fingerprint */
+  void measure(Shell::Statistics::IndexTelemetry& res) const final override
+  {
+    for (const auto& group : _data) {
+      res.entries += group.size();
+    }
+    res.nodes += _fingerprints.size();
+    res.depth = std::max(res.depth, 1u);
+  }
+
+  void markTerms() const override
+  {
+    for (const auto& group : _data) {
+      for (const auto& d : group) {
+        markIndexedTerms(d);
+      }
+    }
+  }
+
+  void output(std::ostream& out) const final override
+  {
+    out << "FingerprintIndex {";
+    for (unsigned i = 0; i < _fingerprints.size(); i++) {
+      out << " " << _fingerprints[i] << ": " << _data[i].size();
+    }
+    out << " }";
+  }
+
+private:
+  /** Retrieval of unifiable terms */
+  struct Unification
+  {
+    typedef ResultSubstitutionSP Unifier;
+    Recycled<RobSubstitution> subs;
+
+    bool useFingerprints() const { return true; }
+    bool compatible(const Fingerprint& query, const Fingerprint& indexed) const
+    { return Fingerprint::mayUnify(query, indexed); }
+    bool check(TypedTermList query, TypedTermList indexed)
+    {
+      subs->reset();
+      return subs->unify(query.sort(), QUERY_BANK, indexed.sort(), RESULT_BANK)
+          && subs->unify(query, QUERY_BANK, indexed, RESULT_BANK);
+    }
+    Unifier unifier(bool retrieveSubstitutions)
+    { return retrieveSubstitutions ? ResultSubstitution::fromSubstitution(&*subs, QUERY_BANK, RESULT_BANK) : ResultSubstitutionSP(); }
+  };
+
+  /** Retrieval of terms unifiable with abstraction */
+  struct UnificationWithAbstraction
+  {
+    typedef AbstractingUnifier* Unifier;
+    AbstractingUnifier unif;
+    AbstractionOracle oracle;
+    bool fixedPointIteration;
+
+    UnificationWithAbstraction(AbstractionOracle ao, bool fixedPointIteration)
+    : unif(AbstractingUnifier::empty(ao)), oracle(ao), fixedPointIteration(fixedPointIteration) {}
+
+    bool useFingerprints() const { return !unif.usesUwa(); }
+    bool compatible(const Fingerprint& query, const Fingerprint& indexed) const
+    { return Fingerprint::mayUnify(query, indexed); }
+    bool check(TypedTermList query, TypedTermList indexed)
+    {
+      unif.init(oracle);
+      return unif.unify(query.sort(), QUERY_BANK, indexed.sort(), RESULT_BANK)
+          && unif.unify(query, QUERY_BANK, indexed, RESULT_BANK)
+          && (!fixedPointIteration || unif.fixedPointIteration());
+    }
+    Unifier unifier(bool retrieveSubstitutions)
+    { return &unif; }
+  };
+
+  /** Retrieval of generalizations (if @b generalizations) or instances of the query */
+  template<bool generalizations>
+  struct Matching
+  {
+    typedef ResultSubstitutionSP Unifier;
+    typedef MatchingSubstitution::BindingMap BindingMap;
+
+    Recycled<BindingMap> bindings;
+
+    bool useFingerprints() const { return true; }
+    bool compatible(const Fingerprint& query, const Fingerprint& indexed) const
+    {
+      return generalizations ? Fingerprint::mayGeneralize(indexed, query)
+                             : Fingerprint::mayGeneralize(query, indexed);
+    }
+    bool check(TypedTermList query, TypedTermList indexed)
+    {
+      bindings->reset();
+      MatchingUtils::MapRefBinder<BindingMap> binder(*bindings);
+      TypedTermList base = generalizations ? indexed : query;
+      TypedTermList instance = generalizations ? query : indexed;
+      return MatchingUtils::matchTerms(base.sort(), instance.sort(), binder)
+          && MatchingUtils::matchTerms(base, instance, binder);
+    }
+    Unifier unifier(bool retrieveSubstitutions)
+    {
+      return retrieveSubstitutions
+        ? ResultSubstitutionSP(new MatchingSubstitution(&*bindings, /* resultBound */ generalizations))
+        : ResultSubstitutionSP();
+    }
+  };
+
+  template<class Retrieval>
+  class ResultIterator
+  {
+  public:
+    typedef QueryRes<typename Retrieval::Unifier, Data> Result;
+    DECL_ELEMENT_TYPE(Result);
+
+    ResultIterator(FingerprintIndex* index, TypedTermList query, bool retrieveSubstitutions, Retrieval retrieval)
+    : _index(index), _query(query), _queryFp(query), _retrieveSubstitutions(retrieveSubstitutions),
+      _retrieval(std::move(retrieval)), _nextGroup(0), _group(nullptr), _nextInGroup(0), _ready(false)
+    {}
+
+    bool hasNext()
+    {
+      while (!_ready) {
+        if (!_group || _nextInGroup == _group->size()) {
+          if (!nextGroup()) {
+            return false;
+          }
+        }
+        const Data& d = (*_group)[_nextInGroup++];
+        _ready = _retrieval.check(_query, d.key());
+      }
+      return true;
+    }
+
+    Result next()
+    {
+      ALWAYS(hasNext());
+      _ready = false;
+      return Result(_retrieval.unifier(_retrieveSubstitutions), &(*_group)[_nextInGroup - 1]);
+    }
+
+  private:
+    bool nextGroup()
+    {
+      auto& fingerprints = _index->_fingerprints;
+      bool useFingerprints = _retrieval.useFingerprints();
+      while (_nextGroup < fingerprints.size()) {
+        unsigned i = _nextGroup++;
+        if (!useFingerprints || _retrieval.compatible(_queryFp, fingerprints[i])) {
+          _group = &_index->_data[i];
+          _nextInGroup = 0;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    FingerprintIndex* _index;
+    TypedTermList _query;
+    Fingerprint _queryFp;
+    bool _retrieveSubstitutions;
+    Retrieval _retrieval;
+    unsigned _nextGroup;
+    Stack<Data>* _group;
+    unsigned _nextInGroup;
+    bool _ready;
+  };
+
+  /** the distinct fingerprints of indexed terms */
+  Stack<Fingerprint> _fingerprints;
+  /** the data of the terms with the fingerprint at the same index of @b _fingerprints */
+  Stack<Stack<Data>> _data;
+  /** the index of each fingerprint in @b _fingerprints */
+  DHMap<Fingerprint, unsigned> _positions;
+};
+
+} // namespace Indexing
+
+#endif /* __FingerprintIndex__ */
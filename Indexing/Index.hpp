@@ -18,15 +18,19 @@
 #include "Forwards.hpp"
 #include "Debug/Output.hpp"
 
+#include "Lib/Environment.hpp"
 #include "Lib/Event.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/Term.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/VirtualIterator.hpp"
+#include "Lib/Metaiterators.hpp"
 #include "Saturation/ClauseContainer.hpp"
 #include "ResultSubstitution.hpp"
 #include "Kernel/UnificationWithAbstraction.hpp"
 #include "Lib/Allocator.hpp"
+#include "TermSharing.hpp"
+#include "Shell/Statistics.hpp"
 
 /**
  * Indices are parametrized by a LeafData, i.e. the bit of data you want to store in the index.
@@ -112,11 +116,13 @@ struct TermLiteralClause
 };
 
 /** Custom leaf data for forward demodulation to store the demodulator
- * left- and right-hand side normalized and cache preorderedness. */
+ * left- and right-hand side normalized and cache preorderedness. The
+ * comparators of demodulators with the same left-hand side are merged
+ * through @b shared, cf. OrderingComparator::Shared. */
 struct DemodulatorData
 {
-  DemodulatorData(TypedTermList term, TermList rhs, Clause* clause, bool preordered, const Ordering& ord)
-    : term(term), rhs(rhs), clause(clause), preordered(preordered), comparator(ord.createComparator(term, rhs))
+  DemodulatorData(TypedTermList term, TermList rhs, Clause* clause, bool preordered, const Ordering& ord, OrderingComparator::SharedSP& shared)
+    : term(term), rhs(rhs), clause(clause), preordered(preordered), comparator(ord.createComparator(term, rhs, shared))
   {
 #if VDEBUG
     ASS(term.containsAllVariablesOf(rhs));
@@ -154,6 +160,39 @@ template<>
 struct is_indexed_data_normalized<DemodulatorData>
 { static constexpr bool value = true; };
 
+/**
+ * Mark the terms of indexed data as reachable, cf. TermSharing::collect().
+ * Most data only need their key marked, the rest comes from clauses.
+ */
+template<class Data>
+void markIndexedTerms(Data const& data)
+{ env.sharing->mark(data.key()); }
+
+inline void markIndexedTerms(TermLiteralClause const& data)
+{
+  env.sharing->mark(data.term);
+  env.sharing->mark(data.literal);
+}
+
+inline void markIndexedTerms(DemodulatorData const& data)
+{
+  // both sides are normalized, so need not occur in any clause
+  env.sharing->mark(data.term);
+  env.sharing->mark(data.rhs);
+}
+
+inline void markIndexedTerms(TermWithValue<Literal*> const& data)
+{
+  env.sharing->mark(data.term);
+  env.sharing->mark(data.value);
+}
+
+inline void markIndexedTerms(TermWithValue<TermList> const& data)
+{
+  env.sharing->mark(data.term);
+  env.sharing->mark(data.value);
+}
+
 /**
  * Class of objects which contain results of term queries.
  */
@@ -187,13 +226,53 @@ public:
   virtual ~Index();
 
   void attachContainer(ClauseContainer* cc);
+
+  /**
+   * Postpone the updates of the index until the matching endBatch(), so
+   * they can be applied together. Queries are still answered correctly in
+   * between, they just apply the postponed updates first.
+   */
+  virtual void startBatch() {}
+  virtual void endBatch() {}
+
+  /** Answer the queries known to retrieve nothing without traversing the index, cf. EmptyRetrievalCache */
+  virtual void enableRetrievalCache() {}
+
+  /** The number of clauses added to the index so far */
+  unsigned long additions() const { return _telemetry.additions; }
+
+  /** Count the queries and their results from now on */
+  void enableTelemetry() { _telemetryEnabled = true; }
+  /** The counters of the index, including the current size of its structure */
+  virtual Shell::Statistics::IndexTelemetry telemetry() const { return _telemetry; }
 protected:
   Index() {}
 
   void onAddedToContainer(Clause* c)
-  { handleClause(c, true); }
+  {
+    _telemetry.additions++;
+    handleClause(c, true);
+  }
   void onRemovedFromContainer(Clause* c)
-  { handleClause(c, false); }
+  {
+    _telemetry.removals++;
+    handleClause(c, false);
+  }
+
+  /** Count the query whose results are @b it, if telemetry is enabled */
+  template<class Iterator>
+  Iterator countQuery(Iterator it)
+  {
+    if (!_telemetryEnabled) {
+      return it;
+    }
+    _telemetry.queries++;
+    return pvi(iterTraits(std::move(it))
+        .map([this](auto res) {
+          _telemetry.results++;
+          return res;
+        }));
+  }
 
   virtual void handleClause(Clause* c, bool adding) {}
 
@@ -202,6 +281,8 @@ protected:
 private:
   SubscriptionData _addedSD;
   SubscriptionData _removedSD;
+  bool _telemetryEnabled = false;
+  Shell::Statistics::IndexTelemetry _telemetry;
 };
 
 };
@@ -21,6 +21,8 @@
 
 #include "AcyclicityIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
+#include "FeatureVectorIndex.hpp"
+#include "FingerprintIndex.hpp"
 #include "GroundingIndex.hpp"
 #include "LiteralIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
@@ -98,6 +100,81 @@ void IndexManager::provideIndex(IndexType t, Index* index)
   _store.set(t,e);
 }
 
+/**
+ * Start a batch of updates in all indices, cf. Index::startBatch()
+ *
+ * The indices must not be requested or released before the matching
+ * call to endBatch().
+ */
+void IndexManager::startBatch()
+{
+  DHMap<IndexType,Entry>::Iterator it(_store);
+  while (it.hasNext()) {
+    it.next().index->startBatch();
+  }
+}
+
+/**
+ * Apply the updates postponed since the matching startBatch()
+ */
+void IndexManager::endBatch()
+{
+  DHMap<IndexType,Entry>::Iterator it(_store);
+  while (it.hasNext()) {
+    it.next().index->endBatch();
+  }
+}
+
+/**
+ * Store the telemetry of the indices in env.statistics
+ */
+void IndexManager::updateStatistics()
+{
+  env.statistics->indices.clear();
+  DHMap<IndexType,Entry>::Iterator it(_store);
+  while (it.hasNext()) {
+    IndexType t;
+    Entry e;
+    it.next(t, e);
+    env.statistics->indices.push_back(std::make_pair(name(t), e.index->telemetry()));
+  }
+}
+
+const char* IndexManager::name(IndexType t)
+{
+  switch(t) {
+  case BINARY_RESOLUTION_SUBST_TREE: return "Binary resolution";
+  case BACKWARD_SUBSUMPTION_SUBST_TREE: return "Backward subsumption";
+  case FW_SUBSUMPTION_UNIT_CLAUSE_SUBST_TREE: return "Forward subsumption unit clauses";
+  case URR_UNIT_CLAUSE_SUBST_TREE: return "URR unit clauses";
+  case URR_UNIT_CLAUSE_WITH_AL_SUBST_TREE: return "URR unit clauses with answer literals";
+  case URR_NON_UNIT_CLAUSE_SUBST_TREE: return "URR non-unit clauses";
+  case URR_NON_UNIT_CLAUSE_WITH_AL_SUBST_TREE: return "URR non-unit clauses with answer literals";
+  case SUPERPOSITION_SUBTERM_SUBST_TREE: return "Superposition subterms";
+  case SUPERPOSITION_LHS_SUBST_TREE: return "Superposition left-hand sides";
+  case SUB_VAR_SUP_SUBTERM_SUBST_TREE: return "Sub-variable superposition subterms";
+  case SUB_VAR_SUP_LHS_SUBST_TREE: return "Sub-variable superposition left-hand sides";
+  case DEMODULATION_SUBTERM_SUBST_TREE: return "Demodulation subterms";
+  case DEMODULATION_LHS_CODE_TREE: return "Demodulation left-hand sides";
+  case FW_SUBSUMPTION_CODE_TREE: return "Forward subsumption code tree";
+  case FW_SUBSUMPTION_SUBST_TREE: return "Forward subsumption";
+  case BW_SUBSUMPTION_SUBST_TREE: return "Backward subsumption literals";
+  case SUBSUMPTION_FEATURE_VECTOR_INDEX: return "Subsumption feature vectors";
+  case FSD_SUBST_TREE: return "Forward subsumption demodulation";
+  case REWRITE_RULE_SUBST_TREE: return "Rewrite rules";
+  case GLOBAL_SUBSUMPTION_INDEX: return "Global subsumption";
+  case ACYCLICITY_INDEX: return "Acyclicity";
+  case NARROWING_INDEX: return "Narrowing";
+  case PRIMITIVE_INSTANTIATION_INDEX: return "Primitive instantiation";
+  case SKOLEMISING_FORMULA_INDEX: return "Skolemising formulas";
+  case RENAMING_FORMULA_INDEX: return "Renaming formulas";
+  case UNIT_INT_COMPARISON_INDEX: return "Unit integer comparisons";
+  case INDUCTION_TERM_INDEX: return "Induction terms";
+  case STRUCT_INDUCTION_TERM_INDEX: return "Structural induction terms";
+  }
+  ASSERTION_VIOLATION;
+}
+
 Index* IndexManager::create(IndexType t)
 {
   Index* res;
@@ -105,6 +182,15 @@ Index* IndexManager::create(IndexType t)
   using LiteralSubstitutionTree = Indexing::LiteralSubstitutionTree<LiteralClause>;
 
   bool isGenerating;
+
+  // the term indices of superposition and demodulation can use fingerprint indexing instead of a substitution tree
+  auto fingerprintIndexing = env.options->fingerprintIndexing();
+  auto newTermIndexingStructure = [&](Options::FingerprintIndexing usedFor) -> TermIndexingStructure<TermLiteralClause>* {
+    if (fingerprintIndexing == usedFor || fingerprintIndexing == Options::FingerprintIndexing::ALL) {
+      return new FingerprintIndex<TermLiteralClause>();
+    }
+    return new TermSubstitutionTree();
+  };
                    
   switch(t) {
   case BINARY_RESOLUTION_SUBST_TREE:
@@ -137,22 +223,22 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case SUPERPOSITION_SUBTERM_SUBST_TREE:
-    res = new SuperpositionSubtermIndex(new TermSubstitutionTree(), _alg->getOrdering());
+    res = new SuperpositionSubtermIndex(newTermIndexingStructure(Options::FingerprintIndexing::SUPERPOSITION), _alg->getOrdering());
     isGenerating = true;
     break;
   case SUPERPOSITION_LHS_SUBST_TREE:
-    res = new SuperpositionLHSIndex(new TermSubstitutionTree(), _alg->getOrdering(), _alg->getOptions());
+    res = new SuperpositionLHSIndex(newTermIndexingStructure(Options::FingerprintIndexing::SUPERPOSITION), _alg->getOrdering(), _alg->getOptions());
     isGenerating = true;
     break;
     
   case SUB_VAR_SUP_SUBTERM_SUBST_TREE:
     //using a substitution tree to store variable.
     //TODO update
-    res = new SubVarSupSubtermIndex(new TermSubstitutionTree(), _alg->getOrdering());
+    res = new SubVarSupSubtermIndex(newTermIndexingStructure(Options::FingerprintIndexing::SUPERPOSITION), _alg->getOrdering());
     isGenerating = true;
     break;
   case SUB_VAR_SUP_LHS_SUBST_TREE:
-    res = new SubVarSupLHSIndex(new TermSubstitutionTree(), _alg->getOrdering(), _alg->getOptions());
+    res = new SubVarSupLHSIndex(newTermIndexingStructure(Options::FingerprintIndexing::SUPERPOSITION), _alg->getOrdering(), _alg->getOptions());
     isGenerating = true;
     break;
   
@@ -176,7 +262,7 @@ Index* IndexManager::create(IndexType t)
     break; 
 
   case DEMODULATION_SUBTERM_SUBST_TREE: {
-    auto tis = new TermSubstitutionTree();
+    auto tis = newTermIndexingStructure(Options::FingerprintIndexing::DEMODULATION);
     if (env.options->combinatorySup()) {
       res = new DemodulationSubtermIndexImpl<true>(tis,_alg->getOptions());
     } else {
@@ -200,6 +286,11 @@ Index* IndexManager::create(IndexType t)
     isGenerating = false;
     break;
 
+  case SUBSUMPTION_FEATURE_VECTOR_INDEX:
+    res = new FeatureVectorIndex();
+    isGenerating = false;
+    break;
+
   case FSD_SUBST_TREE:
     res = new FSDLiteralIndex(new LiteralSubstitutionTree());
     isGenerating = false;
@@ -233,6 +324,12 @@ Index* IndexManager::create(IndexType t)
   default:
     INVALID_OPERATION("Unsupported IndexType.");
   }
+  if (env.options->retrievalCache()) {
+    res->enableRetrievalCache();
+  }
+  if (env.options->statistics() == Options::Statistics::FULL) {
+    res->enableTelemetry();
+  }
   if(isGenerating) {
     res->attachContainer(_alg->getGeneratingClauseContainer());
   }
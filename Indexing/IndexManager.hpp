@@ -51,6 +51,7 @@ enum IndexType {
   FW_SUBSUMPTION_CODE_TREE,
   FW_SUBSUMPTION_SUBST_TREE,
   BW_SUBSUMPTION_SUBST_TREE,
+  SUBSUMPTION_FEATURE_VECTOR_INDEX,
 
   FSD_SUBST_TREE,
 
@@ -86,6 +87,11 @@ public:
   Index* get(IndexType t);
 
   void provideIndex(IndexType t, Index* index);
+
+  void startBatch();
+  void endBatch();
+
+  void updateStatistics();
 private:
 
   struct Entry {
@@ -96,6 +102,7 @@ private:
   DHMap<IndexType,Entry> _store;
 
   Index* create(IndexType t);
+  static const char* name(IndexType t);
   Shell::Options::UnificationWithAbstraction _uwa;
   bool _uwaFixedPointIteration;
 };
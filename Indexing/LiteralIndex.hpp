@@ -21,6 +21,7 @@
 
 #include "Index.hpp"
 #include "LiteralIndexingStructure.hpp"
+#include "RetrievalCache.hpp"
 
 
 namespace Indexing {
@@ -34,20 +35,35 @@ public:
   { return _is->getAll(); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getUnifications(Literal* lit, bool complementary, bool retrieveSubstitutions = true)
-  { return _is->getUnifications(lit, complementary, retrieveSubstitutions); }
+  { return cached(lit, complementary, UNIFICATIONS, [&]() { return _is->getUnifications(lit, complementary, retrieveSubstitutions); }); }
 
   VirtualIterator<QueryRes<AbstractingUnifier*, Data>> getUwa(Literal* lit, bool complementary, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
-  { return _is->getUwa(lit, complementary, uwa, fixedPointIteration); }
+  { return cached(lit, complementary, UWA, [&]() { return _is->getUwa(lit, complementary, uwa, fixedPointIteration); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getGeneralizations(Literal* lit, bool complementary, bool retrieveSubstitutions = true)
-  { return _is->getGeneralizations(lit, complementary, retrieveSubstitutions); }
+  { return cached(lit, complementary, GENERALIZATIONS, [&]() { return _is->getGeneralizations(lit, complementary, retrieveSubstitutions); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getInstances(Literal* lit, bool complementary, bool retrieveSubstitutions = true)
-  { return _is->getInstances(lit, complementary, retrieveSubstitutions); }
+  { return cached(lit, complementary, INSTANCES, [&]() { return _is->getInstances(lit, complementary, retrieveSubstitutions); }); }
 
   size_t getUnificationCount(Literal* lit, bool complementary)
   { return _is->getUnificationCount(lit, complementary); }
 
+  void startBatch() override { _is->startBatch(); }
+  void endBatch() override { _is->endBatch(); }
+
+  void enableRetrievalCache() override
+  { _cache = std::make_unique<EmptyRetrievalCache<std::tuple<Literal*, bool, unsigned>>>(); }
+
+  Shell::Statistics::IndexTelemetry telemetry() const override
+  {
+    auto res = Index::telemetry();
+    if (_cache) {
+      res.cacheHits = _cache->hits();
+    }
+    _is->measure(res);
+    return res;
+  }
 
   friend std::ostream& operator<<(std::ostream& out,                 LiteralIndex const& self) { return out << *self._is; }
   friend std::ostream& operator<<(std::ostream& out, OutputMultiline<LiteralIndex>const& self) { return out << multiline(*self.self._is, self.indent); }
@@ -59,6 +75,21 @@ protected:
   { _is->handle(std::move(data), add); }
 
   std::unique_ptr<LiteralIndexingStructure<Data>> _is;
+
+private:
+  enum RetrievalKind { UWA, UNIFICATIONS, GENERALIZATIONS, INSTANCES };
+
+  /** Answer the query @b lit by @b retrieve unless the cache knows there are no results, cf. Index::countQuery() */
+  template<class Retrieve>
+  auto cached(Literal* lit, bool complementary, RetrievalKind kind, Retrieve retrieve)
+  {
+    if (!_cache) {
+      return countQuery(retrieve());
+    }
+    return countQuery(_cache->template retrieve<decltype(retrieve())>(additions(), std::make_tuple(lit, complementary, (unsigned)kind), retrieve));
+  }
+
+  std::unique_ptr<EmptyRetrievalCache<std::tuple<Literal*, bool, unsigned>>> _cache;
 };
 
 class BinaryResolutionIndex
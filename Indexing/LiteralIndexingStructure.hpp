@@ -34,6 +34,16 @@ public:
   void insert(LeafData ld) { handle(std::move(ld), /* insert = */ true ); }
   void remove(LeafData ld) { handle(std::move(ld), /* insert = */ false); }
 
+  /**
+   * Between startBatch() and the matching endBatch() the structure may
+   * postpone the updates and apply them together. Batches can be nested.
+   */
+  virtual void startBatch() {}
+  virtual void endBatch() {}
+
+  /** Add the number of entries and nodes of the structure to @b res, and raise its depth to that of the structure */
+  virtual void measure(Shell::Statistics::IndexTelemetry& res) const {}
+
   virtual VirtualIterator<LeafData> getAll() { NOT_IMPLEMENTED; }
   virtual VirtualIterator<QueryRes<ResultSubstitutionSP, LeafData>> getUnifications(Literal* lit, bool complementary, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual VirtualIterator<QueryRes<AbstractingUnifier*, LeafData>> getUwa(Literal* lit, bool complementary, Options::UnificationWithAbstraction uwa, bool fixedPointIteration) = 0;
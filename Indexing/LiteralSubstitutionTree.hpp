@@ -47,7 +47,37 @@ public:
     { }
 
   void handle(LeafData ld, bool insert) final override
-  { getTree(ld.key(), /* complementary */ false).handle(std::move(ld), insert); }
+  {
+    auto& tree = getTree(ld.key(), /* complementary */ false);
+    if (_batchDepth) {
+      if (!tree.hasPending()) {
+        _batched.push(&tree);
+      }
+      tree.defer(std::move(ld), insert);
+    } else {
+      tree.handle(std::move(ld), insert);
+    }
+  }
+
+  void measure(Shell::Statistics::IndexTelemetry& res) const final override
+  {
+    for (auto& t : _trees) {
+      t->measure(res);
+    }
+  }
+
+  void startBatch() final override
+  { _batchDepth++; }
+
+  void endBatch() final override
+  {
+    ASS_G(_batchDepth, 0);
+    if (--_batchDepth == 0) {
+      while (_batched.isNonEmpty()) {
+        _batched.pop()->flushBatch();
+      }
+    }
+  }
 
   VirtualIterator<LeafData> getAll() final override
   {
@@ -168,6 +198,9 @@ private:
   }
 
   Stack<std::unique_ptr<SubstitutionTree>> _trees;
+  unsigned _batchDepth = 0;
+  /** the trees that may have updates postponed in the current batch */
+  Stack<SubstitutionTree*> _batched;
 };
 
 };
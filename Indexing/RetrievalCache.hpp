@@ -0,0 +1,88 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file RetrievalCache.hpp
+ * Defines class EmptyRetrievalCache.
+ */
+
+#ifndef __RetrievalCache__
+#define __RetrievalCache__
+
+#include <tuple>
+
+#include "Lib/DHSet.hpp"
+#include "Lib/Environment.hpp"
+
+#include "TermSharing.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Remembers the queries for which an index retrieved nothing, so that
+ * repeating them does not traverse the index again. Removals cannot create
+ * new results, so the answers stay valid until the next clause is added to
+ * the index, which is detected by comparing the count of Index::additions().
+ *
+ * The queries are perfectly shared terms or literals, so the keys are tuples
+ * of their pointers and of whatever else determines the query, such as the
+ * kind of retrieval. The terms of the keys are kept alive by the cache, so
+ * their memory cannot be reused for other terms while they are cached.
+ */
+template<class Key>
+class EmptyRetrievalCache
+: public TermRoot
+{
+public:
+  /**
+   * Return the results of @b retrieve, a function returning an iterator over
+   * the results of the query @b key, unless it is known that there are none.
+   */
+  template<class Iterator, class Retrieve>
+  Iterator retrieve(unsigned long additions, Key key, Retrieve retrieve)
+  {
+    if (_additions != additions) {
+      _keys.reset();
+      _additions = additions;
+    }
+    if (_keys.find(key)) {
+      _hits++;
+      return Iterator::getEmpty();
+    }
+    Iterator res = retrieve();
+    if (!res.hasNext()) {
+      _keys.insert(key);
+    }
+    return res;
+  }
+
+  /** The number of queries answered by the cache */
+  unsigned long hits() const { return _hits; }
+
+  void markTerms() const override
+  {
+    typename DHSet<Key>::Iterator it(_keys);
+    while (it.hasNext()) {
+      env.sharing->mark(std::get<0>(it.next()));
+    }
+  }
+
+private:
+  /** the count of additions to the index at which the cache was last valid */
+  unsigned long _additions = 0;
+  unsigned long _hits = 0;
+  DHSet<Key> _keys;
+};
+
+};
+
+#endif /* __RetrievalCache__ */
@@ -82,24 +82,35 @@ struct BindingComparator
 
 
 /**
- * Insert an entry to the substitution tree.
- *
- * @b pnode is pointer to root of tree corresponding to
- * top symbol of the term/literal being inserted, and
- * @b bh contains its arguments.
+ * Insert the @b n entries at @b lds, all with the same key, into the leaf
+ * at @b pleaf, converting it to a more efficient representation as it grows.
+ */
+template<class LeafData_>
+void SubstitutionTree<LeafData_>::insertIntoLeaf(Leaf** pleaf, LeafData* lds, unsigned n)
+{
+  for (unsigned i = 0; i < n; i++) {
+    ensureLeafEfficiency(pleaf);
+    (*pleaf)->insert(std::move(lds[i]));
+  }
+}
+
+/**
+ * Insert the @b n entries at @b lds to the substitution tree. The
+ * entries have the same key, whose arguments are bound in @b svBindings,
+ * so the tree is descended only once for all of them.
  */
 template<class LeafData_>
-void SubstitutionTree<LeafData_>::insert(BindingMap& svBindings, LeafData ld)
+void SubstitutionTree<LeafData_>::insert(BindingMap& svBindings, LeafData* lds, unsigned n)
 {
   ASS_EQ(_iterCnt,0);
+  ASS_G(n, 0);
   auto pnode = &_root;
   DEBUG_INSERT(0, "insert: ", svBindings, " into ", *this)
 
   if(*pnode == 0) {
     if (svBindings.isEmpty()) {
-      auto leaf = createLeaf();
-      leaf->insert(std::move(ld));
-      *pnode = leaf;
+      *pnode = createLeaf();
+      insertIntoLeaf(reinterpret_cast<Leaf**>(pnode), lds, n);
       DEBUG_INSERT(0, "out: ", *this);
       return;
     } else {
@@ -108,8 +119,7 @@ void SubstitutionTree<LeafData_>::insert(BindingMap& svBindings, LeafData ld)
   }
   if(svBindings.isEmpty()) {
     ASS((*pnode)->isLeaf());
-    ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
-    static_cast<Leaf*>(*pnode)->insert(ld);
+    insertIntoLeaf(reinterpret_cast<Leaf**>(pnode), lds, n);
     DEBUG_INSERT(0, "out: ", *this);
     return;
   }
@@ -214,9 +224,8 @@ start:
       *pnode = inode;
       pnode = inode->childByTop(term.top(),true);
     }
-    Leaf* lnode=createLeaf(term);
-    *pnode=lnode;
-    lnode->insert(ld);
+    *pnode=createLeaf(term);
+    insertIntoLeaf(reinterpret_cast<Leaf**>(pnode), lds, n);
 
     ensureIntermediateNodeEfficiency(reinterpret_cast<IntermediateNode**>(pparent));
     DEBUG_INSERT(0, "out: ", *this);
@@ -290,9 +299,7 @@ start:
 
   if (svBindings.isEmpty()) {
     ASS((*pnode)->isLeaf());
-    ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
-    Leaf* leaf = static_cast<Leaf*>(*pnode);
-    leaf->insert(ld);
+    insertIntoLeaf(reinterpret_cast<Leaf**>(pnode), lds, n);
     DEBUG_INSERT(0, "out: ", *this);
     return;
   }
@@ -301,19 +308,18 @@ start:
 } // // SubstitutionTree<LeafData_>::insert
 
 /*
- * Remove an entry from the substitution tree.
- *
- * @b pnode is pointer to root of tree corresponding to
- * top symbol of the term/literal being removed, and
- * @b bh contains its arguments.
+ * Remove the @b n entries at @b lds from the substitution tree. The
+ * entries have the same key, whose arguments are bound in @b svBindings,
+ * so the tree is descended only once for all of them.
  *
  * If the removal results in a chain of nodes containing
  * no terms/literals, all those nodes are removed as well.
  */
 template<class LeafData_>
-void SubstitutionTree<LeafData_>::remove(BindingMap& svBindings, LeafData ld)
+void SubstitutionTree<LeafData_>::remove(BindingMap& svBindings, LeafData* lds, unsigned n)
 {
   ASS_EQ(_iterCnt,0);
+  ASS_G(n, 0);
   auto pnode = &_root;
   DEBUG_REMOVE(0, "remove: ", svBindings, " from ", *this)
 
@@ -382,7 +388,9 @@ void SubstitutionTree<LeafData_>::remove(BindingMap& svBindings, LeafData ld)
 
 
   Leaf* lnode = static_cast<Leaf*>(*pnode);
-  lnode->remove(ld);
+  for (unsigned i = 0; i < n; i++) {
+    lnode->remove(std::move(lds[i]));
+  }
   ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
 
   while( (*pnode)->isEmpty() ) {
@@ -526,6 +534,7 @@ SubstitutionTree<LeafData_>::LeafIterator::LeafIterator(SubstitutionTree* st)
   : _curr()
   , _nodeIterators()
 {
+  st->flushBatch();
   if (st->_root->isLeaf()) {
     _curr = st->_root;
   } else {
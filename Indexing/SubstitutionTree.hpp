@@ -151,6 +151,7 @@ template<class LD> std::ostream& operator<<(std::ostream& out, OutputMultiline<S
  */
 template<class LeafData_>
 class SubstitutionTree final
+  : public TermRoot
 {
 
 public:
@@ -164,6 +165,8 @@ public:
   static void swap(SubstitutionTree& self, SubstitutionTree& other) {
     std::swap(self._nextVar, other._nextVar);
     std::swap(self._root,    other._root);
+    std::swap(self._pending, other._pending);
+    std::swap(self._pendingInsert, other._pendingInsert);
   }
   SubstitutionTree& operator=(SubstitutionTree && other) { swap(*this,other); return *this; }
   SubstitutionTree(SubstitutionTree&& other) : SubstitutionTree() { swap(*this, other); }
@@ -176,6 +179,59 @@ public:
     delete _root;
   }
 
+  /** Mark the terms of the nodes and of the leaf data, cf. TermSharing::collect() */
+  void markTerms() const override
+  {
+    for (auto& ld : _pending) {
+      markIndexedTerms(ld);
+    }
+    if (!_root) {
+      return;
+    }
+    Stack<Node*> todo;
+    todo.push(_root);
+    while (todo.isNonEmpty()) {
+      Node* node = todo.pop();
+      // nodes may have terms with special variables, not shared
+      env.sharing->mark(node->term());
+      if (node->isLeaf()) {
+        auto ldit = static_cast<Leaf*>(node)->allChildren();
+        while (ldit.hasNext()) {
+          markIndexedTerms(*ldit.next());
+        }
+      } else {
+        auto nit = static_cast<IntermediateNode*>(node)->allChildren();
+        while (nit.hasNext()) {
+          todo.push(*nit.next());
+        }
+      }
+    }
+  }
+
+  /** Add the entries and nodes of the tree to @b res, cf. TermIndexingStructure::measure() */
+  void measure(Shell::Statistics::IndexTelemetry& res) const
+  {
+    if (!_root) {
+      return;
+    }
+    Stack<std::pair<Node*, unsigned>> todo;
+    todo.push(std::make_pair(_root, 1u));
+    while (todo.isNonEmpty()) {
+      auto [node, depth] = todo.pop();
+      res.nodes++;
+      res.depth = std::max(res.depth, depth);
+      if (node->isLeaf()) {
+        // skip list leaves only know their size in debug mode
+        res.entries += countIteratorElements(static_cast<Leaf*>(node)->allChildren());
+      } else {
+        auto nit = static_cast<IntermediateNode*>(node)->allChildren();
+        while (nit.hasNext()) {
+          todo.push(std::make_pair(*nit.next(), depth + 1));
+        }
+      }
+    }
+  }
+
 #define VERBOSE_OUTPUT_OPERATORS 0
   friend std::ostream& operator<<(std::ostream& out, SubstitutionTree const& self)
   {
@@ -213,7 +269,8 @@ public:
   template<class I> using QueryResultIter = VirtualIterator<QueryRes<LeafData, typename I::Unifier>>;
   template<class I, class TermOrLit, class... Args>
   auto iterator(TermOrLit query, bool retrieveSubstitutions, bool reversed, Args... args)
-  { return isEmpty() ? VirtualIterator<ELEMENT_TYPE(I)>::getEmpty()
+  { flushBatch();
+    return isEmpty() ? VirtualIterator<ELEMENT_TYPE(I)>::getEmpty()
                      : pvi(iterPointer(Recycled<I>(this, _root, query, retrieveSubstitutions, reversed, std::move(args)...)));
   }
 
@@ -239,10 +296,29 @@ public:
     SET=3
   };
 
+  /**
+   * The top symbol of a term packed into one word, so that the children of
+   * a node can be told apart without dereferencing them: variable v is
+   * encoded as 4v, and symbol f of kind k as 4f + 1 + k.
+   */
+  static uint64_t topKey(TermList t)
+  {
+    return t.isVar() ? uint64_t(t.var()) << 2
+                     : (uint64_t(t.term()->functor()) << 2) | (1 + unsigned(t.term()->kind()));
+  }
+  static uint64_t topKey(TermList::Top t)
+  {
+    return t.var() ? uint64_t(*t.var()) << 2
+                   : (uint64_t(t.functor()->functor) << 2) | (1 + unsigned(t.functor()->kind));
+  }
+  static bool isVarKey(uint64_t key) { return (key & 3) == 0; }
+
   class Node {
 
     /** term at this node */
     TermList _term;
+    /** true for leaves, kept here so that traversals do not need a virtual call to find out */
+    const bool _isLeaf;
 #define CACHE_FUNCTOR 0
 #if CACHE_FUNCTOR
     /** if _term is a Term* we cache the functor so we are faster than calling _term->term(); */
@@ -254,11 +330,11 @@ public:
     { self.self.output(out, /* multiline = */ true, self.indent); return out; }
     friend std::ostream& operator<<(std::ostream& out, Node const& self) 
     { self.output(out, /* multiline = */ false, /* indent */ 0); return out; }
-    inline Node() : _term(TermList::empty()) {}
-    inline Node(TermList ts) : Node() { setTerm(ts); }
+    inline Node(bool isLeaf) : _term(TermList::empty()), _isLeaf(isLeaf) {}
+    inline Node(bool isLeaf, TermList ts) : Node(isLeaf) { setTerm(ts); }
     virtual ~Node();
     /** True if a leaf node */
-    virtual bool isLeaf() const = 0;
+    bool isLeaf() const { return _isLeaf; }
     virtual bool isEmpty() const = 0;
     /**
      * Return number of elements held in the node.
@@ -308,14 +384,11 @@ public:
     public:
       /** Build a new intermediate node which will serve as the root*/
       inline
-      IntermediateNode(unsigned childVar) : childVar(childVar) {}
+      IntermediateNode(unsigned childVar) : Node(/* isLeaf */ false), childVar(childVar) {}
 
       /** Build a new intermediate node */
       inline
-      IntermediateNode(TermList ts, unsigned childVar) : Node(ts), childVar(childVar) {}
-
-      inline
-      bool isLeaf() const final override { return false; };
+      IntermediateNode(TermList ts, unsigned childVar) : Node(/* isLeaf */ false, ts), childVar(childVar) {}
 
       virtual NodeIterator allChildren() = 0;
       virtual NodeIterator variableChildren() = 0;
@@ -365,14 +438,11 @@ public:
     public:
       /** Build a new leaf which will serve as the root */
       inline
-      Leaf()
+      Leaf() : Node(/* isLeaf */ true)
       {}
       /** Build a new leaf */
       inline
-      Leaf(TermList ts) : Node(ts) {}
-
-      inline
-      bool isLeaf() const final override { return true; };
+      Leaf(TermList ts) : Node(/* isLeaf */ true, ts) {}
       virtual LDIterator allChildren() = 0;
       virtual void insert(LeafData ld) = 0;
       virtual void remove(LeafData ld) = 0;
@@ -428,9 +498,9 @@ public:
 
       NodeIterator variableChildren()
       {
-        return pvi( arrayIter(_nodes, _size)
-              .filter([](auto& n) { return n->term().isVar(); })
-              .map([](Node *& n) { return &n; }));
+        return pvi( range(0, _size)
+              .filter([this](int i) { return isVarKey(_keys[i]); })
+              .map([this](int i) { return &_nodes[i]; }));
       }
       virtual Node** childByTop(TermList::Top t, bool canCreate);
       void remove(TermList::Top t);
@@ -438,7 +508,10 @@ public:
       USE_ALLOCATOR(UArrIntermediateNode);
 
       int _size;
+      /** null-terminated */
       Node* _nodes[UARR_INTERMEDIATE_NODE_MAX_SIZE+1];
+      /** topKey() of the child at the same index of @b _nodes */
+      uint64_t _keys[UARR_INTERMEDIATE_NODE_MAX_SIZE+1];
     };
 
     class SListIntermediateNode
@@ -570,18 +643,90 @@ public:
             _nextVar = std::max(_nextVar, var + 1);
             bindings->insert(var, term);
           });
-      if (doInsert) insert(*bindings, ld);
-      else          remove(*bindings, ld);
+      if (doInsert) insert(*bindings, &ld, 1);
+      else          remove(*bindings, &ld, 1);
+    }
+
+    /**
+     * Queue the insertion or removal of @b ld until the next flushBatch().
+     * Queries flush the queue themselves, so the postponed updates are never
+     * observable. A removal following queued insertions (or vice versa) also
+     * flushes the queue first, so the updates are applied in their order.
+     */
+    void defer(LeafData ld, bool doInsert)
+    {
+      if (_pending.isNonEmpty() && _pendingInsert != doInsert) {
+        flushBatch();
+      }
+      _pendingInsert = doInsert;
+      _pending.push(std::move(ld));
+    }
+
+    bool hasPending() const { return _pending.isNonEmpty(); }
+
+    /**
+     * Apply the updates queued by defer(). The entries are sorted by their
+     * normalised keys, and all entries with the same key are inserted into
+     * (or removed from) their leaf during a single descent from the root.
+     */
+    void flushBatch()
+    {
+      if (_pending.isEmpty()) {
+        return;
+      }
+      using Key = decltype(Renaming::normalize(_pending.top().key()));
+      Recycled<Stack<std::pair<Key, unsigned>>> order;
+      for (unsigned i = 0; i < _pending.size(); i++) {
+        order->push(std::make_pair(Renaming::normalize(_pending[i].key()), i));
+      }
+      order->sort([](auto const& l, auto const& r) { return batchOrder(l.first) < batchOrder(r.first); });
+
+      Stack<LeafData> sorted(_pending.size());
+      for (auto& e : *order) {
+        sorted.push(std::move(_pending[e.second]));
+      }
+      _pending.reset();
+
+      unsigned start = 0;
+      while (start < sorted.size()) {
+        auto key = (*order)[start].first;
+        unsigned end = start + 1;
+        while (end < sorted.size() && batchOrder((*order)[end].first) == batchOrder(key)) {
+          end++;
+        }
+        Recycled<BindingMap> bindings;
+        createBindings(key, /* reversed */ false,
+            [&](int var, auto term) {
+              _nextVar = std::max(_nextVar, var + 1);
+              bindings->insert(var, term);
+            });
+        if (_pendingInsert) insert(*bindings, sorted.begin() + start, end - start);
+        else                remove(*bindings, sorted.begin() + start, end - start);
+        start = end;
+      }
     }
 
   private:
-    void insert(BindingMap& binding,LeafData ld);
-    void remove(BindingMap& binding,LeafData ld);
+    void insert(BindingMap& binding, LeafData* lds, unsigned n);
+    void remove(BindingMap& binding, LeafData* lds, unsigned n);
+    void insertIntoLeaf(Leaf** pleaf, LeafData* lds, unsigned n);
+
+    /** the order of the keys in a batch, equal exactly for equal normalised keys */
+    static std::pair<uint64_t, uint64_t> batchOrder(TypedTermList t)
+    { return std::make_pair(t.content(), t.sort().content()); }
+    static std::pair<uint64_t, uint64_t> batchOrder(TermList t)
+    { return std::make_pair(t.content(), 0); }
+    static std::pair<uint64_t, uint64_t> batchOrder(Literal* l)
+    { return std::make_pair(reinterpret_cast<uint64_t>(l), 0); }
 
     /** Number of the next variable */
     int _nextVar = 0;
     Node* _root = nullptr;
     Cntr _iterCnt;
+    /** updates queued by defer() */
+    Stack<LeafData> _pending;
+    /** whether the queued updates are insertions */
+    bool _pendingInsert = true;
 
   public:
 
@@ -613,6 +758,7 @@ public:
     template<class Query>
     bool generalizationExists(Query query)
     {
+      flushBatch();
       return _root == nullptr 
         ? false
         : FastGeneralizationsIterator(this, _root, query, /* retrieveSubstitutions */ false, /* reversed */ false).hasNext();
@@ -621,6 +767,7 @@ public:
     template<class Query>
     VirtualIterator<QueryRes<ResultSubstitutionSP, LeafData>> getVariants(Query query, bool retrieveSubstitutions)
     {
+      flushBatch();
       auto renaming = retrieveSubstitutions ? std::make_unique<RenamingSubstitution>() : std::unique_ptr<RenamingSubstitution>(nullptr);
       ResultSubstitutionSP resultSubst = retrieveSubstitutions ? ResultSubstitutionSP(&*renaming) : ResultSubstitutionSP();
 
@@ -1342,8 +1489,8 @@ public:
 
 
   public:
-    bool maybeEmpty() const { return _root == nullptr; }
-    bool isEmpty() const { return _root == nullptr || _root->isEmpty(); }
+    bool maybeEmpty() const { return _root == nullptr && _pending.isEmpty(); }
+    bool isEmpty() const { return (_root == nullptr || _root->isEmpty()) && _pending.isEmpty(); }
   }; // class SubstiutionTree
 
   /* This namespace defines classes to be used as type parameter for SubstitutionTree::Iterator. 
@@ -422,38 +422,46 @@ bool SubstitutionTree<LeafData_>::FastGeneralizationsIterator::enterNode(Node*&
 
   if(currType==UNSORTED_LIST) {
     Node** nl=static_cast<UArrIntermediateNode*>(inode)->_nodes;
+    //the keys of the children tell us their top symbols without visiting them
+    const uint64_t* keys=static_cast<UArrIntermediateNode*>(inode)->_keys;
     if(binding.isTerm()) {
-      unsigned bindingFunctor=binding.term()->functor();
+      uint64_t bindingKey=topKey(binding);
       //let's first skip proper term nodes at the beginning...
-      while(*nl && (*nl)->term().isTerm()) {
+      while(*nl && !isVarKey(*keys)) {
         //...and have the one that interests us, if we encounter it.
-        if(!curr && (*nl)->term().term()->functor()==bindingFunctor) {
+        if(!curr && *keys==bindingKey) {
           curr=*nl;
         }
         nl++;
+        keys++;
       }
       if(!curr && *nl) {
         //we've encountered a variable node, but we still have to check, whether
         //the one proper term node, that interests us, isn't here
         Node** nl2=nl+1;
+        const uint64_t* keys2=keys+1;
         while(*nl2) {
-          if((*nl2)->term().isTerm() && (*nl2)->term().term()->functor()==bindingFunctor) {
+          if(*keys2==bindingKey) {
             curr=*nl2;
             break;
           }
           nl2++;
+          keys2++;
         }
       }
     } else {
       //let's first skip proper term nodes at the beginning
-      while(*nl && (*nl)->term().isTerm()) {
+      while(*nl && !isVarKey(*keys)) {
         nl++;
+        keys++;
       }
     }
     if(!curr && *nl) {
       curr=*(nl++);
-      while(*nl && (*nl)->term().isTerm()) {
+      keys++;
+      while(*nl && !isVarKey(*keys)) {
 	nl++;
+	keys++;
       }
     }
     if(curr) {
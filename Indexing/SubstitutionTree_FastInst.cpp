@@ -536,15 +536,18 @@ bool SubstitutionTree<LeafData_>::FastInstancesIterator::enterNode(Node*& curr)
     ASS(*nl); //inode is not empty
     bool noAlternatives=false;
     if(query.isTerm()) {
-      unsigned bindingFunctor=query.term()->functor();
-      //let's skip terms that don't have the same top functor...
-      while(*nl && (!(*nl)->term().isTerm() || (*nl)->term().term()->functor()!=bindingFunctor)) {
+      //let's skip terms that don't have the same top functor, which the keys
+      //of the children tell us without visiting them
+      const uint64_t* keys=static_cast<UArrIntermediateNode*>(inode)->_keys;
+      uint64_t queryKey=topKey(query);
+      while(*nl && *keys!=queryKey) {
         nl++;
+        keys++;
       }
 
       if(*nl) {
 	//we've found the term with the same top functor
-	ASS_EQ((*nl)->term().term()->functor(),bindingFunctor);
+	ASS_EQ((*nl)->term().term()->functor(),query.term()->functor());
         curr=*nl;
         noAlternatives=true; //there is at most one term with each top functor
       }
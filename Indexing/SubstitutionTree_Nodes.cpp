@@ -165,14 +165,17 @@ template<class LeafData_>
 typename SubstitutionTree<LeafData_>::Node** SubstitutionTree<LeafData_>::UArrIntermediateNode::
 	childByTop(TermList::Top t, bool canCreate)
 {
+  uint64_t key=topKey(t);
   for(int i=0;i<_size;i++) {
-    if(t == _nodes[i]->top()) {
+    if(_keys[i]==key) {
+      ASS(!_nodes[i] || _nodes[i]->top()==t);
       return &_nodes[i];
     }
   }
   if(canCreate) {
     ASS_L(_size,UARR_INTERMEDIATE_NODE_MAX_SIZE);
     ASS_EQ(_nodes[_size],0);
+    _keys[_size]=key;
     _nodes[++_size]=0;
     return &_nodes[_size-1];
   }
@@ -182,10 +185,12 @@ typename SubstitutionTree<LeafData_>::Node** SubstitutionTree<LeafData_>::UArrIn
 template<class LeafData_>
 void SubstitutionTree<LeafData_>::UArrIntermediateNode::remove(TermList::Top t)
 {
+  uint64_t key=topKey(t);
   for(int i=0;i<_size;i++) {
-    if(t == _nodes[i]->top()) {
+    if(_keys[i]==key) {
       _size--;
       _nodes[i]=_nodes[_size];
+      _keys[i]=_keys[_size];
       _nodes[_size]=0;
       return;
     }
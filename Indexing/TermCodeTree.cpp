@@ -40,6 +40,12 @@ void TermCodeTree<Data>::onCodeOpDestroying(CodeOp* op)
   }
 }
 
+template<class Data>
+void TermCodeTree<Data>::markSuccessResult(const CodeOp* op) const
+{
+  markIndexedTerms(*op->getSuccessResult<Data>());
+}
+
 template<class Data>
 TermCodeTree<Data>::TermCodeTree()
 {
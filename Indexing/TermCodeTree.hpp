@@ -43,6 +43,7 @@ class TermCodeTree : public CodeTree
 {
 protected:
   static void onCodeOpDestroying(CodeOp* op);
+  void markSuccessResult(const CodeOp* op) const override;
   
 public:
   TermCodeTree();
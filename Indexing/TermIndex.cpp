@@ -49,7 +49,7 @@ void SuperpositionSubtermIndex::handleClause(Clause* c, bool adding)
                                               : EqHelper::getSubtermIterator(lit,_ord);
     while (rsti.hasNext()) {
       auto tt = TypedTermList(rsti.next());
-      ((TermSubstitutionTree<TermLiteralClause>*)&*_is)->handle(TermLiteralClause{ tt, lit, c }, adding);
+      _is->handle(TermLiteralClause{ tt, lit, c }, adding);
     }
   }
 }
@@ -63,7 +63,7 @@ void SuperpositionLHSIndex::handleClause(Clause* c, bool adding)
     Literal* lit=(*c)[i];
     auto lhsi = EqHelper::getSuperpositionLHSIterator(lit, _ord, _opt);
     while (lhsi.hasNext()) {
-	    _tree->handle(TermLiteralClause{ lhsi.next(), lit, c }, adding);
+	    _is->handle(TermLiteralClause{ lhsi.next(), lit, c }, adding);
     }
   }
 }
@@ -136,12 +136,26 @@ void DemodulationLHSIndex::handleClause(Clause* c, bool adding)
     Renaming r;
     r.normalizeVariables(lhs);
 
+    TypedTermList lhsN(r.apply(lhs),r.apply(lhs.sort()));
+
+    // the demodulators with the same left-hand side share their comparator data
+    ComparatorData* cd;
+    _comparatorData.getValuePtr(lhsN, cd);
     DemodulatorData dd(
-      TypedTermList(r.apply(lhs),r.apply(lhs.sort())),
+      lhsN,
       r.apply(EqHelper::getOtherEqualitySide(lit, lhs)),
-      c, preordered, _ord
+      c, preordered, _ord, cd->shared
     );
     _is->handle(std::move(dd), adding);
+
+    if (adding) {
+      cd->demodulators++;
+    } else {
+      ASS_G(cd->demodulators, 0);
+      if (--cd->demodulators == 0) {
+        _comparatorData.remove(lhsN);
+      }
+    }
   }
 }
 
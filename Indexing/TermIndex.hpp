@@ -18,8 +18,10 @@
 
 #include "Index.hpp"
 
+#include "Indexing/RetrievalCache.hpp"
 #include "Indexing/TermSubstitutionTree.hpp"
 #include "TermIndexingStructure.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Set.hpp"
 
 namespace Indexing {
@@ -32,16 +34,32 @@ public:
   virtual ~TermIndex() {}
 
   VirtualIterator<QueryRes<AbstractingUnifier*, Data>> getUwa(TypedTermList t, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
-  { return _is->getUwa(t, uwa, fixedPointIteration); }
+  { return cached(t, UWA, [&]() { return _is->getUwa(t, uwa, fixedPointIteration); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getUnifications(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getUnifications(t, retrieveSubstitutions); }
+  { return cached(t, UNIFICATIONS, [&]() { return _is->getUnifications(t, retrieveSubstitutions); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getGeneralizations(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getGeneralizations(t, retrieveSubstitutions); }
+  { return cached(t, GENERALIZATIONS, [&]() { return _is->getGeneralizations(t, retrieveSubstitutions); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getInstances(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getInstances(t, retrieveSubstitutions); }
+  { return cached(t, INSTANCES, [&]() { return _is->getInstances(t, retrieveSubstitutions); }); }
+
+  void enableRetrievalCache() override
+  { _cache = std::make_unique<EmptyRetrievalCache<std::tuple<Term*, unsigned>>>(); }
+
+  void startBatch() override { _is->startBatch(); }
+  void endBatch() override { _is->endBatch(); }
+
+  Shell::Statistics::IndexTelemetry telemetry() const override
+  {
+    auto res = Index::telemetry();
+    if (_cache) {
+      res.cacheHits = _cache->hits();
+    }
+    _is->measure(res);
+    return res;
+  }
 
   friend std::ostream& operator<<(std::ostream& out, TermIndex const& self)
   { return out << *self._is; }
@@ -49,6 +67,22 @@ protected:
   TermIndex(TermIndexingStructure<Data>* is) : _is(is) {}
 
   std::unique_ptr<TermIndexingStructure<Data>> _is;
+
+private:
+  enum RetrievalKind { UWA, UNIFICATIONS, GENERALIZATIONS, INSTANCES };
+
+  /** Answer the query @b t by @b retrieve unless the cache knows there are no results, cf. Index::countQuery() */
+  template<class Retrieve>
+  auto cached(TypedTermList t, RetrievalKind kind, Retrieve retrieve)
+  {
+    // the sort of a non-variable term is determined by the term
+    if (!_cache || t.isVar()) {
+      return countQuery(retrieve());
+    }
+    return countQuery(_cache->template retrieve<decltype(retrieve())>(additions(), std::make_tuple(t.term(), (unsigned)kind), retrieve));
+  }
+
+  std::unique_ptr<EmptyRetrievalCache<std::tuple<Term*, unsigned>>> _cache;
 };
 
 class SuperpositionSubtermIndex
@@ -67,14 +101,13 @@ class SuperpositionLHSIndex
 : public TermIndex<TermLiteralClause>
 {
 public:
-  SuperpositionLHSIndex(TermSubstitutionTree<TermLiteralClause>* is, Ordering& ord, const Options& opt)
-  : TermIndex(is), _ord(ord), _opt(opt), _tree(is) {};
+  SuperpositionLHSIndex(TermIndexingStructure<TermLiteralClause>* is, Ordering& ord, const Options& opt)
+  : TermIndex(is), _ord(ord), _opt(opt) {};
 protected:
   void handleClause(Clause* c, bool adding);
 private:
   Ordering& _ord;
   const Options& _opt;
-  TermSubstitutionTree<TermLiteralClause>* _tree;
 };
 
 /**
@@ -117,8 +150,16 @@ public:
 protected:
   void handleClause(Clause* c, bool adding);
 private:
+  struct ComparatorData {
+    OrderingComparator::SharedSP shared;
+    /** number of demodulators with the left-hand side in the index */
+    unsigned demodulators = 0;
+  };
+
   Ordering& _ord;
   const Options& _opt;
+  /** comparator data shared by the demodulators with the same normalized left-hand side */
+  DHMap<TermList, ComparatorData> _comparatorData;
 };
 
 /**
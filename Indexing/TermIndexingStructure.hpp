@@ -29,6 +29,16 @@ public:
   void insert(Data data) { handle(std::move(data), /* insert */ true ); }
   void remove(Data data) { handle(std::move(data), /* insert */ false); }
 
+  /**
+   * Between startBatch() and the matching endBatch() the structure may
+   * postpone the updates and apply them together. Batches can be nested.
+   */
+  virtual void startBatch() {}
+  virtual void endBatch() {}
+
+  /** Add the number of entries and nodes of the structure to @b res, and raise its depth to that of the structure */
+  virtual void measure(Shell::Statistics::IndexTelemetry& res) const {}
+
   virtual VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getUnifications(TypedTermList t, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual VirtualIterator<QueryRes<AbstractingUnifier*, Data>> getUwa(TypedTermList t, Options::UnificationWithAbstraction uwa, bool fixedPointIteration) = 0;
   virtual VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getUnificationsUsingSorts(TypedTermList tt, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }  
@@ -16,13 +16,18 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
+#include "Kernel/Clause.hpp"
+#include "Kernel/Formula.hpp"
+#include "Kernel/FormulaUnit.hpp"
 #include "Kernel/Signature.hpp"
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/OperatorType.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
 #include "Kernel/ApplicativeHelper.hpp"
+#include "Kernel/SubformulaIterator.hpp"
 
 #include "Shell/Statistics.hpp"
 #include "Debug/TimeProfiling.hpp"
@@ -35,12 +40,40 @@ using namespace Indexing;
 
 typedef ApplicativeHelper AH;
 
+TermRoot* TermRoot::s_first = nullptr;
+
+TermRoot::TermRoot()
+  : _previous(nullptr),
+    _next(s_first)
+{
+  if (_next) {
+    _next->_previous = this;
+  }
+  s_first = this;
+}
+
+TermRoot::~TermRoot()
+{
+  if (_previous) {
+    _previous->_next = _next;
+  } else {
+    ASS_EQ(s_first, this);
+    s_first = _next;
+  }
+  if (_next) {
+    _next->_previous = _previous;
+  }
+}
+
 /**
  * Initialise the term sharing structure.
  * @since 29/12/2007 Manchester
  */
 TermSharing::TermSharing()
-  : _poly(true),
+  : _termIds(0),
+    _literalIds(0),
+    _collecting(false),
+    _poly(true),
     _wellSortednessCheckingDisabled(false)
 {
 }
@@ -52,15 +85,15 @@ TermSharing::TermSharing()
 TermSharing::~TermSharing()
 {
 #if CHECK_LEAKS
-  Set<Term*,TermSharing>::Iterator ts(_terms);
+  TaggedSet<Term*,TermSharing>::Iterator ts(_terms);
   while (ts.hasNext()) {
     ts.next()->destroy();
   }
-  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  TaggedSet<Literal*,TermSharing>::Iterator ls(_literals);
   while (ls.hasNext()) {
     ls.next()->destroy();
   }
-  Set<AtomicSort*,TermSharing>::Iterator ss(_sorts);
+  TaggedSet<AtomicSort*,TermSharing>::Iterator ss(_sorts);
   while (ss.hasNext()) {
     ss.next()->destroy();
   }
@@ -85,6 +118,8 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
 
     unsigned weight = 1;
     unsigned vars = 0;
+    unsigned depth = 0;
+    uint64_t symbols = Term::symbolBit(t->functor());
     bool hasInterpretedConstants=t->arity()==0 &&
 	env.signature->getFunction(t->functor())->interpreted();
     bool hasTermVar = false;
@@ -151,6 +186,8 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
   
         vars += r->numVarOccs();
         weight += r->weight();
+        depth = max(depth, r->depth());
+        symbols |= r->symbolBitmap();
         hasTermVar |= r->hasTermVar();
         if (env.colorUsed) {
           color = static_cast<Color>(color | r->color());
@@ -161,9 +198,11 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
       }
     }
     t->markShared();
-    t->setId(_terms.size());
+    t->setId(++_termIds);
     t->setNumVarOccs(vars);
     t->setWeight(weight);
+    t->setDepth(depth + 1);
+    t->setSymbolBitmap(symbols);
     t->setHasTermVar(hasTermVar);
     if (env.colorUsed) {
       Color fcolor = env.signature->getFunction(t->functor())->color();
@@ -172,6 +211,9 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
     }
 
     t->setInterpretedConstantsPresence(hasInterpretedConstants);
+    if (_collecting && t->arity()) {
+      _collectableTerms.push(t);
+    }
 
     //poly function works for mono as well, but is slow
     //it is fine to use for debug
@@ -197,6 +239,8 @@ void TermSharing::computeAndSetSharedSortData(AtomicSort* sort)
     }
     unsigned weight = 1;
     unsigned vars = 0;
+    unsigned depth = 0;
+    uint64_t symbols = Term::symbolBit(sort->functor());
 
     for (TermList* tt = sort->args(); ! tt->isEmpty(); tt = tt->next()) {
       if (tt->isVar()) {
@@ -212,12 +256,16 @@ void TermSharing::computeAndSetSharedSortData(AtomicSort* sort)
   
         vars += r->numVarOccs();
         weight += r->weight();
+        depth = max(depth, r->depth());
+        symbols |= r->symbolBitmap();
       }
     }
     sort->markShared();
     sort->setId(_sorts.size());
     sort->setNumVarOccs(vars);
     sort->setWeight(weight);
+    sort->setDepth(depth + 1);
+    sort->setSymbolBitmap(symbols);
 
     ASS_REP(SortHelper::allTopLevelArgsAreSorts(sort), sort->toString());
     if (!SortHelper::allTopLevelArgsAreSorts(sort)){
@@ -243,6 +291,9 @@ void TermSharing::computeAndSetSharedLiteralData(Literal* t)
 
     unsigned weight = 1;
     unsigned vars = 0;
+    unsigned depth = 0;
+    // the predicate symbol is not included, it is compared separately
+    uint64_t symbols = 0;
     Color color = COLOR_TRANSPARENT;
     bool hasInterpretedConstants=false;
 
@@ -261,6 +312,8 @@ void TermSharing::computeAndSetSharedLiteralData(Literal* t)
         Term* r = tt->term();
         vars += r->numVarOccs();
         weight += r->weight();
+        depth = max(depth, r->depth());
+        symbols |= r->symbolBitmap();
 
         if (env.colorUsed) {
           ASS(color == COLOR_TRANSPARENT || r->color() == COLOR_TRANSPARENT || color == r->color());
@@ -272,15 +325,20 @@ void TermSharing::computeAndSetSharedLiteralData(Literal* t)
       }
     }
     t->markShared();
-    t->setId(_literals.size());
+    t->setId(++_literalIds);
     t->setNumVarOccs(vars);
     t->setWeight(weight);
+    t->setDepth(depth + 1);
+    t->setSymbolBitmap(symbols);
     if (env.colorUsed) {
       Color fcolor = env.signature->getPredicate(t->functor())->color();
       color = static_cast<Color>(color | fcolor);
       t->setColor(color);
     }
     t->setInterpretedConstantsPresence(hasInterpretedConstants);
+    if (_collecting && t->arity()) {
+      _collectableLiterals.push(t);
+    }
 
     ASS_REP(_wellSortednessCheckingDisabled || SortHelper::areImmediateSortsValidPoly(t), t->toString());
     if (!_poly && !SortHelper::areImmediateSortsValidMono(t) && !_wellSortednessCheckingDisabled){
@@ -312,7 +370,7 @@ void TermSharing::computeAndSetSharedVarEqData(Literal* t, TermList sort)
   t->setTwoVarEqSort(sort);
 
     t->markShared();
-    t->setId(_literals.size());
+    t->setId(++_literalIds);
     // 3 since we have two variables and the equality symbol itself.
     // Additionally, we need sort.weight() in the polymorphic case since
     // the sort may contain variables and Vampire assumes the invariant
@@ -324,10 +382,15 @@ void TermSharing::computeAndSetSharedVarEqData(Literal* t, TermList sort)
     // However, we don't want the calculation to depend on _poly
     // which switches from 1 to possibly 0 only after preprocessing.
     t->setWeight(3 + (sort.weight() - 1));
+    t->setDepth(1);
+    t->setSymbolBitmap(0);
     if (env.colorUsed) {
       t->setColor(COLOR_TRANSPARENT);
     }
     t->setInterpretedConstantsPresence(false);
+    if (_collecting) {
+      _collectableLiterals.push(t);
+    }
 } // TermSharing::computeAndSetSharedVarEqData
 
 /**
@@ -407,3 +470,164 @@ bool TermSharing::equals(const Term* s,const Term* t)
   }
   return true;
 } // TermSharing::equals
+
+/**
+ * From now on, record the terms and literals created, so that they can be collected
+ * once they are unreachable. Those created so far are kept for good.
+ *
+ * Reachability is decided from the clauses in existence, the formulas they derive from,
+ * and the terms marked by each TermRoot, so any other structure keeping terms created from
+ * now on must be a TermRoot. Collection is therefore only enabled for saturation
+ * (cf. SaturationAlgorithm::termCollectionSupported()).
+ */
+void TermSharing::startCollection()
+{
+  ASS(!_collecting);
+  _collecting = true;
+  Clause::trackLiveClauses(true);
+} // TermSharing::startCollection
+
+/** Keep all terms and literals created so far for good */
+void TermSharing::stopCollection()
+{
+  _collecting = false;
+  _collectableTerms.reset();
+  _collectableLiterals.reset();
+  Clause::trackLiveClauses(false);
+} // TermSharing::stopCollection
+
+/** Mark @b t and its subterms as reachable in the current collection */
+void TermSharing::mark(Term* t)
+{
+  static Stack<Term*> todo;
+  ASS(todo.isEmpty());
+  todo.push(t);
+  while (todo.isNonEmpty()) {
+    t = todo.pop();
+    if (t->shared()) {
+      // terms kept for good may stay marked, their subterms are all kept as well
+      if (t->_marked) {
+        continue;
+      }
+      t->_marked = true;
+    }
+    // terms that are not shared, such as those of substitution trees, may contain special variables
+    for (TermList* arg = t->args(); arg->isNonEmpty(); arg = arg->next()) {
+      if (arg->isTerm()) {
+        todo.push(arg->term());
+      }
+    }
+  }
+} // TermSharing::mark
+
+/** Mark @b l and its arguments as reachable in the current collection */
+void TermSharing::mark(Literal* l)
+{
+  if (l->shared()) {
+    if (l->_marked) {
+      return;
+    }
+    l->_marked = true;
+  }
+  for (TermList* arg = l->args(); arg->isNonEmpty(); arg = arg->next()) {
+    mark(*arg);
+  }
+  if (l->isTwoVarEquality()) {
+    mark(l->twoVarEqSort());
+  }
+} // TermSharing::mark
+
+/** Mark the literals and boolean terms of @b f as reachable in the current collection */
+void TermSharing::mark(Formula* f)
+{
+  SubformulaIterator sfit(f);
+  while (sfit.hasNext()) {
+    Formula* sf = sfit.next();
+    if (sf->connective() == LITERAL) {
+      mark(sf->literal());
+    } else if (sf->connective() == BOOL_TERM) {
+      mark(sf->getBooleanTerm());
+    }
+  }
+} // TermSharing::mark
+
+/**
+ * Keep the marked objects of @b collectable, unmarking them, and move the others to @b garbage
+ */
+template<class T>
+void TermSharing::sweep(Stack<T*>& collectable, Stack<T*>& garbage)
+{
+  unsigned kept = 0;
+  for (T* t : collectable) {
+    if (t->_marked) {
+      t->_marked = false;
+      collectable[kept++] = t;
+    } else {
+      garbage.push(t);
+    }
+  }
+  collectable.truncate(kept);
+} // TermSharing::sweep
+
+/**
+ * Destroy the terms and literals created since startCollection() that are no longer reachable,
+ * and return their number.
+ *
+ * Must only be called when no terms are in use apart from the reachable ones, e.g. between
+ * the steps of saturation, when the only terms in use are those of the clauses in existence,
+ * of the formulas they derive from, and of the TermRoot objects, such as indices.
+ */
+unsigned TermSharing::collect()
+{
+  ASS(_collecting);
+  TIME_TRACE("term collection");
+
+  // the clauses in existence and the formulas they are derived from
+  DHSet<Unit*> visited;
+  Stack<Unit*> units;
+  DHSet<Clause*>::Iterator cit(*Clause::liveClauses());
+  while (cit.hasNext()) {
+    Clause* cl = cit.next();
+    for (Literal* l : cl->iterLits()) {
+      mark(l);
+    }
+    units.push(cl);
+  }
+  while (units.isNonEmpty()) {
+    Inference& inf = units.pop()->inference();
+    Inference::Iterator iit = inf.iterator();
+    while (inf.hasNext(iit)) {
+      Unit* premise = inf.next(iit);
+      // clauses in existence are all visited above
+      if (!premise->isClause() && visited.insert(premise)) {
+        mark(static_cast<FormulaUnit*>(premise)->formula());
+        units.push(premise);
+      }
+    }
+  }
+
+  for (TermRoot* root = TermRoot::s_first; root; root = root->_next) {
+    root->markTerms();
+  }
+
+  Stack<Term*> terms;
+  sweep(_collectableTerms, terms);
+  Stack<Literal*> literals;
+  sweep(_collectableLiterals, literals);
+  // remove all the unreachable ones before destroying any, as removal compares terms
+  for (Term* t : terms) {
+    ALWAYS(_terms.remove(t));
+  }
+  for (Literal* l : literals) {
+    ALWAYS(_literals.remove(l));
+  }
+  for (Term* t : terms) {
+    t->markUnshared();
+    t->destroy();
+  }
+  for (Literal* l : literals) {
+    l->markUnshared();
+    l->destroy();
+  }
+  return terms.size() + literals.size();
+} // TermSharing::collect
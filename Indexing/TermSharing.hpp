@@ -17,7 +17,8 @@
 #ifndef __TermSharing__
 #define __TermSharing__
 
-#include "Lib/Set.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/TaggedSet.hpp"
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -27,6 +28,30 @@ using namespace Kernel;
 
 namespace Indexing {
 
+/**
+ * A structure keeping shared terms or literals apart from the clauses containing them,
+ * such as an index. When unreachable terms are collected (cf. TermSharing::collect()),
+ * every root in existence marks the terms it keeps.
+ */
+class TermRoot
+{
+public:
+  TermRoot();
+  TermRoot(const TermRoot&) : TermRoot() {}
+  TermRoot& operator=(const TermRoot&) { return *this; }
+  virtual ~TermRoot();
+
+  /** Mark the terms and literals kept by this structure, cf. TermSharing::mark() */
+  virtual void markTerms() const = 0;
+
+private:
+  friend class TermSharing;
+  /** the roots in existence form an intrusive list, so that they can be created anywhere, even statically */
+  static TermRoot* s_first;
+  TermRoot* _previous;
+  TermRoot* _next;
+};
+
 class TermSharing
 {
 public:
@@ -92,7 +117,22 @@ public:
   };
   bool isWellSortednessCheckingDisabled() const { return _wellSortednessCheckingDisabled; }
 
+  void startCollection();
+  void stopCollection();
+  /** True if the terms and literals created from now on may be collected */
+  bool collecting() const { return _collecting; }
+  unsigned collect();
+
+  void mark(Term* t);
+  void mark(Literal* l);
+  void mark(Formula* f);
+  void mark(TermList t)
+  { if (t.isTerm()) { mark(t.term()); } }
+
 private:
+  template<class T>
+  static void sweep(Stack<T*>& collectable, Stack<T*>& garbage);
+
   friend class Kernel::Term;
   friend class Kernel::Literal;
   friend class Kernel::AtomicSort;
@@ -100,16 +140,30 @@ private:
   static bool argNormGt(TermList t1, TermList t2);
 
   /** The set storing all terms */
-  Set<Term*,TermSharing> _terms;
+  TaggedSet<Term*,TermSharing> _terms;
   /** The set storing all literals */
-  Set<Literal*,TermSharing> _literals;
+  TaggedSet<Literal*,TermSharing> _literals;
   /** The set storing all sorts */
-  Set<AtomicSort*,TermSharing> _sorts;
+  TaggedSet<AtomicSort*,TermSharing> _sorts;
   /* Set containing all array sorts. 
    * Can be deleted once array axioms are made truly poltmorphic
    */  
   DHSet<TermList> _arraySorts;
 
+  /** the number of terms and literals created, from which their ids are taken */
+  unsigned _termIds;
+  unsigned _literalIds;
+
+  /** True if the terms and literals created from now on may be collected */
+  bool _collecting;
+  /**
+   * The terms and literals that may be collected, none of them marked between collections.
+   * Constants and propositional literals are never collected: they are cheap,
+   * and symbol tables refer to them.
+   */
+  Stack<Term*> _collectableTerms;
+  Stack<Literal*> _collectableLiterals;
+
   bool _poly;
   bool _wellSortednessCheckingDisabled;
 }; // class TermSharing
@@ -52,6 +52,7 @@ class TermSubstitutionTree
   using LeafIterator                = typename SubstitutionTree::LeafIterator;
 
   Indexing::SubstitutionTree<LeafData_> _inner;
+  unsigned _batchDepth = 0;
 public:
   using LeafData = LeafData_;
   
@@ -60,7 +61,24 @@ public:
     { }
 
   void handle(LeafData d, bool insert) final override
-  { _inner.handle(std::move(d), insert); }
+  {
+    if (_batchDepth) _inner.defer(std::move(d), insert);
+    else             _inner.handle(std::move(d), insert);
+  }
+
+  void measure(Shell::Statistics::IndexTelemetry& res) const final override
+  { _inner.measure(res); }
+
+  void startBatch() final override
+  { _batchDepth++; }
+
+  void endBatch() final override
+  {
+    ASS_G(_batchDepth, 0);
+    if (--_batchDepth == 0) {
+      _inner.flushBatch();
+    }
+  }
 
 private:
 
@@ -45,12 +45,21 @@ void BackwardSubsumptionAndResolution::attach(SaturationAlgorithm *salg)
   _bwIndex = static_cast<BackwardSubsumptionIndex *>(
       _salg->getIndexManager()->request(BACKWARD_SUBSUMPTION_SUBST_TREE)
   );
+  _fvIndex = nullptr;
+  if (getOptions().featureVectorSubsumption()) {
+    _fvIndex = static_cast<FeatureVectorIndex *>(
+        _salg->getIndexManager()->request(SUBSUMPTION_FEATURE_VECTOR_INDEX));
+  }
 }
 
 void BackwardSubsumptionAndResolution::detach()
 {
   _bwIndex = 0;
   _salg->getIndexManager()->release(BACKWARD_SUBSUMPTION_SUBST_TREE);
+  if (_fvIndex) {
+    _fvIndex = 0;
+    _salg->getIndexManager()->release(SUBSUMPTION_FEATURE_VECTOR_INDEX);
+  }
   BackwardSimplificationEngine::detach();
 }
 
@@ -141,7 +150,26 @@ void BackwardSubsumptionAndResolution::perform(Clause *cl,
     }
   }
 
-  if (!_subsumptionByUnitsOnly) {
+  /*******************************************************/
+  /*      SUBSUMPTION MULTI-LITERAL (FEATURE VECTORS)    */
+  /*******************************************************/
+  // Subsumption resolution does not preserve features, so it is left to the
+  // literal index below. Only the subsumed clauses are marked as checked,
+  // the others may still be resolved.
+  bool fvSubsumption = _fvIndex && _subsumption && !_subsumptionByUnitsOnly;
+  if (fvSubsumption) {
+    auto it = _fvIndex->getSubsumedCandidates(cl);
+    while (it.hasNext()) {
+      Clause *icl = it.next();
+      if (_satSubs.checkSubsumption(cl, icl, false)) {
+        ALWAYS(_checked.insert(icl));
+        env.statistics->backwardSubsumed++;
+        List<BwSimplificationRecord>::push(BwSimplificationRecord(icl), simplificationBuffer);
+      }
+    }
+  }
+
+  if (!_subsumptionByUnitsOnly && (!fvSubsumption || (_subsumptionResolution && !_srByUnitsOnly))) {
     // find the positively matched literals
     auto it = _bwIndex->getInstances(lit, false, false);
     while (it.hasNext()) {
@@ -149,7 +177,7 @@ void BackwardSubsumptionAndResolution::perform(Clause *cl,
       if (!_checked.insert(icl))
         continue;
       // check subsumption and setup subsumption resolution at the same time
-      bool checkS = _subsumption && !_subsumptionByUnitsOnly;
+      bool checkS = _subsumption && !_subsumptionByUnitsOnly && !fvSubsumption;
       bool checkSR = _subsumptionResolution && !_srByUnitsOnly;
       if (checkS) {
         if (_satSubs.checkSubsumption(cl, icl, checkSR)) {
@@ -33,6 +33,16 @@ DemodulationHelper::DemodulationHelper(const Options& opts, const Ordering* ord)
 }
 
 bool DemodulationHelper::redundancyCheckNeededForPremise(Clause* rwCl, Literal* rwLit, TermList rwTerm) const
+{
+  return redundancyCheckNeededForPremise(rwCl->length(), rwLit, rwTerm);
+}
+
+bool DemodulationHelper::redundancyCheckNeededForPremise(const LiteralStack& rwLits, Literal* rwLit, TermList rwTerm) const
+{
+  return redundancyCheckNeededForPremise(rwLits.size(), rwLit, rwTerm);
+}
+
+bool DemodulationHelper::redundancyCheckNeededForPremise(unsigned rwLength, Literal* rwLit, TermList rwTerm) const
 {
   if (!_redundancyCheck) {
     return false;
@@ -43,7 +53,7 @@ bool DemodulationHelper::redundancyCheckNeededForPremise(Clause* rwCl, Literal*
   }
 
   // check is needed if encompassment demodulation is off or we demodulate a positive unit
-  return !_encompassing || (rwLit->isPositive() && (rwCl->length() == 1));
+  return !_encompassing || (rwLit->isPositive() && (rwLength == 1));
 }
 
 /**
@@ -76,7 +86,20 @@ bool DemodulationHelper::isRenamingOn(const SubstApplicator* applicator, TermLis
 bool DemodulationHelper::isPremiseRedundant(Clause* rwCl, Literal* rwLit, TermList rwTerm,
   TermList tgtTerm, TermList eqLHS, const SubstApplicator* eqApplicator) const
 {
-  ASS(redundancyCheckNeededForPremise(rwCl, rwLit, rwTerm));
+  return isPremiseRedundant(rwCl->length(), rwCl->iterLits(), rwLit, rwTerm, tgtTerm, eqLHS, eqApplicator);
+}
+
+bool DemodulationHelper::isPremiseRedundant(const LiteralStack& rwLits, Literal* rwLit, TermList rwTerm,
+  TermList tgtTerm, TermList eqLHS, const SubstApplicator* eqApplicator) const
+{
+  return isPremiseRedundant(rwLits.size(), iterTraits(rwLits.iter()), rwLit, rwTerm, tgtTerm, eqLHS, eqApplicator);
+}
+
+template<class LitIt>
+bool DemodulationHelper::isPremiseRedundant(unsigned rwLength, LitIt rwLits, Literal* rwLit, TermList rwTerm,
+  TermList tgtTerm, TermList eqLHS, const SubstApplicator* eqApplicator) const
+{
+  ASS(redundancyCheckNeededForPremise(rwLength, rwLit, rwTerm));
 
   TermList other=EqHelper::getOtherEqualitySide(rwLit, rwTerm);
   if (_ord->compare(tgtTerm, other) == Ordering::LESS) {
@@ -89,7 +112,7 @@ bool DemodulationHelper::isPremiseRedundant(Clause* rwCl, Literal* rwLit, TermLi
   }
 
   // return early to avoid creation of eqLitS
-  if (rwCl->length()==1) {
+  if (rwLength==1) {
     return false;
   }
 
@@ -104,7 +127,7 @@ bool DemodulationHelper::isPremiseRedundant(Clause* rwCl, Literal* rwLit, TermLi
   //
   // Hence we need to check if there are any literals
   // in rwCl greater than eqLitS.
-  return rwCl->iterLits().any([rwLit,this,eqLitS](Literal* lit) {
+  return rwLits.any([rwLit,this,eqLitS](Literal* lit) {
     return lit != rwLit && _ord->compare(eqLitS, lit)==Ordering::LESS;
   });
 }
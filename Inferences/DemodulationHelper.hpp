@@ -30,7 +30,17 @@ public:
   bool isPremiseRedundant(Clause* rwCl, Literal* rwLit, TermList rwTerm, TermList tgtTerm,
     TermList eqLHS, const SubstApplicator* applicator) const;
 
+  /** The same checks for a clause that is being rewritten and only exists as its literals @b rwLits */
+  bool redundancyCheckNeededForPremise(const LiteralStack& rwLits, Literal* rwLit, TermList rwTerm) const;
+  bool isPremiseRedundant(const LiteralStack& rwLits, Literal* rwLit, TermList rwTerm, TermList tgtTerm,
+    TermList eqLHS, const SubstApplicator* applicator) const;
+
 private:
+  bool redundancyCheckNeededForPremise(unsigned rwLength, Literal* rwLit, TermList rwTerm) const;
+  template<class LitIt>
+  bool isPremiseRedundant(unsigned rwLength, LitIt rwLits, Literal* rwLit, TermList rwTerm, TermList tgtTerm,
+    TermList eqLHS, const SubstApplicator* applicator) const;
+
   bool _redundancyCheck;
   bool _encompassing;
   const Ordering* _ord;
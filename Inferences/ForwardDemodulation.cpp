@@ -22,6 +22,7 @@
 #include "Lib/Timer.hpp"
 #include "Lib/VirtualIterator.hpp"
 
+#include "Kernel/BottomUpEvaluation.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/EqHelper.hpp"
 #include "Kernel/Inference.hpp"
@@ -79,12 +80,18 @@ void ForwardDemodulation::attach(SaturationAlgorithm* salg)
   ForwardSimplificationEngine::attach(salg);
   _index=static_cast<DemodulationLHSIndex*>(
 	  _salg->getIndexManager()->request(DEMODULATION_LHS_CODE_TREE) );
+  readOptions();
+}
 
+void ForwardDemodulation::readOptions()
+{
   auto opt = getOptions();
   _preorderedOnly = opt.forwardDemodulation()==Options::Demodulation::PREORDERED;
   _encompassing = opt.demodulationRedundancyCheck()==Options::DemodulationRedundancyCheck::ENCOMPASS;
   _precompiledComparison = opt.demodulationPrecompiledComparison();
   _skipNonequationalLiterals = opt.demodulationOnlyEquational();
+  // the colour of a clause can change with every rewrite, which the normal form does not follow
+  _normalForm = opt.forwardDemodulationNormalForm() && !env.colorUsed;
   _helper = DemodulationHelper(opt, &_salg->getOrdering());
 }
 
@@ -95,12 +102,310 @@ void ForwardDemodulation::detach()
   ForwardSimplificationEngine::detach();
 }
 
+bool ForwardDemodulation::isIrreducible(Term* t)
+{
+  if (_irreducible.additions != _index->additions()) {
+    _irreducible.terms.reset();
+    _irreducible.additions = _index->additions();
+    return false;
+  }
+  return _irreducible.terms.find(t);
+}
+
+void ForwardDemodulation::setIrreducible(Term* t)
+{
+  ASS_EQ(_irreducible.additions, _index->additions());
+  _irreducible.terms.insert(t);
+}
+
+void ForwardDemodulation::IrreducibleTerms::markTerms() const
+{
+  DHSet<Term*>::Iterator it(terms);
+  while (it.hasNext()) {
+    env.sharing->mark(it.next());
+  }
+}
+
+/**
+ * Try to rewrite @b trm at the top with a demodulator from the index. The term
+ * occurs in the literal @b lit of the clause of colour @b color consisting of
+ * @b lits, which is either a Clause* or the LiteralStack of a clause being
+ * rewritten. If @b redundancyCheck is true, the demodulation must also make
+ * the clause redundant.
+ *
+ * On success, the rewritten term is assigned to @b res and the demodulator
+ * used to @b demodulator.
+ */
+template<class Lits>
+bool ForwardDemodulation::rewrite(Color color, const Lits& lits, Literal* lit, TypedTermList trm, bool redundancyCheck,
+  TermList& res, const DemodulatorData*& demodulator)
+{
+  if (isIrreducible(trm.term())) {
+    return false;
+  }
+
+  Ordering& ordering = _salg->getOrdering();
+
+  // stays true while every demodulator was rejected for reasons
+  // that do not depend on the clause being rewritten
+  bool irreducible = true;
+
+  auto git = _index->getGeneralizations(trm.term(), /* retrieveSubstitutions */ true);
+  while(git.hasNext()) {
+    auto qr=git.next();
+    ASS_EQ(qr.data->clause->length(),1);
+
+    if(!ColorHelper::compatible(color, qr.data->clause->color())) {
+      irreducible = false;
+      continue;
+    }
+
+    auto lhs = qr.data->term;
+
+    // TODO:
+    // to deal with polymorphic matching
+    // Ideally, we would like to extend the substitution
+    // returned by the index to carry out the sort match.
+    // However, ForwardDemodulation uses a CodeTree as its
+    // indexing mechanism, and it is not clear how to extend
+    // the substitution returned by a code tree.
+    static RobSubstitution eqSortSubs;
+    if(lhs.isVar()){
+      eqSortSubs.reset();
+      TermList querySort = trm.sort();
+      TermList eqSort = qr.data->term.sort();
+      if(!eqSortSubs.match(eqSort, 0, querySort, 1)){
+        continue;
+      }
+    }
+
+    TermList rhs = qr.data->rhs;
+    bool preordered = qr.data->preordered;
+
+    auto subs = qr.unifier;
+    ASS(subs->isIdentityOnQueryWhenResultBound());
+
+    ApplicatorWithEqSort applWithEqSort(subs.ptr(), eqSortSubs);
+    Applicator applWithoutEqSort(subs.ptr());
+    auto appl = lhs.isVar() ? (SubstApplicator*)&applWithEqSort : (SubstApplicator*)&applWithoutEqSort;
+
+    if (_precompiledComparison) {
+      if (!preordered && (_preorderedOnly || !qr.data->comparator->check(appl))) {
+        continue;
+      }
+    } else {
+      if (!preordered && (_preorderedOnly || !ordering.isGreater(AppliedTerm(trm),AppliedTerm(rhs,appl,true)))) {
+        continue;
+      }
+    }
+
+    // encompassing demodulation is fine when rewriting the smaller guy
+    if (redundancyCheck && _encompassing) {
+      // this will only run at most once;
+      // could have been factored out of the getGeneralizations loop,
+      // but then it would run exactly once there
+      Ordering::Result litOrder = ordering.getEqualityArgumentOrder(lit);
+      if ((trm==*lit->nthArgument(0) && litOrder == Ordering::LESS) ||
+          (trm==*lit->nthArgument(1) && litOrder == Ordering::GREATER)) {
+        redundancyCheck = false;
+      }
+    }
+
+    TermList rhsS = subs->applyToBoundResult(rhs);
+    if (lhs.isVar()) {
+      rhsS = eqSortSubs.apply(rhsS, 0);
+    }
+
+    if (redundancyCheck && !_helper.isPremiseRedundant(lits, lit, trm, rhsS, lhs, appl)) {
+      irreducible = false;
+      continue;
+    }
+
+    res = rhsS;
+    demodulator = qr.data;
+    return true;
+  }
+  if (irreducible) {
+    setIrreducible(trm.term());
+  }
+  return false;
+}
+
+bool ForwardDemodulation::rewriteInNormalForm(Literal* lit, TypedTermList trm, bool redundancyCheck, TermList& res)
+{
+  NormalForm& nf = _nf;
+  const DemodulatorData* demodulator;
+  if (!rewrite(nf.cl->color(), nf.lits, lit, trm, redundancyCheck, res, demodulator)) {
+    return false;
+  }
+  if (nf.premiseSet.insert(demodulator->clause)) {
+    nf.premises.push(demodulator->clause);
+  }
+  nf.steps++;
+  nf.lastDemodulator = demodulator;
+  nf.lastTarget = trm;
+  return true;
+}
+
+/**
+ * Return the term @b t with its term arguments replaced by @b args
+ */
+static TermList replaceArgs(Term* t, const TermList* args)
+{
+  bool changed = false;
+  for (unsigned i = 0; i < t->numTermArguments(); i++) {
+    changed |= args[i] != t->termArg(i);
+  }
+  if (!changed) {
+    return TermList(t);
+  }
+  RStack<TermList> allArgs;
+  for (unsigned i = 0; i < t->numTypeArguments(); i++) {
+    allArgs->push(t->typeArg(i));
+  }
+  for (unsigned i = 0; i < t->numTermArguments(); i++) {
+    allArgs->push(args[i]);
+  }
+  return TermList(Term::create(t, allArgs->begin()));
+}
+
+/**
+ * Rewrite @b t to its normal form, bottom up. This is only done for strict
+ * subterms of literals and for literal arguments that need no redundancy check.
+ */
+TermList ForwardDemodulation::normalise(TypedTermList t)
+{
+  if (t.isVar() || t.term()->isSpecial()) {
+    return t;
+  }
+  return BottomUpEvaluation<TypedTermList, TermList>()
+    .function([&](TypedTermList orig, TermList* args) -> TermList {
+      if (orig.isVar()) {
+        return orig;
+      }
+      TermList res = replaceArgs(orig.term(), args);
+      TermList rhs;
+      while (res.isTerm() && rewriteInNormalForm(nullptr, TypedTermList(res, orig.sort()), /* redundancyCheck */ false, rhs)) {
+        res = normaliseArgs(TypedTermList(rhs, orig.sort()));
+      }
+      return res;
+    })
+    .evNonRec([](TypedTermList t) {
+      return someIf(t.isVar() || t.term()->isSpecial(), [&]() -> TermList { return t; });
+    })
+    .memo<NormalForm::Memo&>(_nf.memo)
+    .apply(t);
+}
+
+/**
+ * Rewrite the arguments of @b t to their normal forms.
+ */
+TermList ForwardDemodulation::normaliseArgs(TypedTermList t)
+{
+  if (t.isVar() || t.term()->isSpecial()) {
+    return t;
+  }
+  Term* trm = t.term();
+  RStack<TermList> args;
+  for (unsigned i = 0; i < trm->numTermArguments(); i++) {
+    args->push(normalise(TypedTermList(trm->termArg(i), SortHelper::getTermArgSort(trm, i))));
+  }
+  return replaceArgs(trm, args->begin());
+}
+
+/**
+ * Rewrite @b cl to its normal form w.r.t. the demodulators in the index, so
+ * that only the final clause is created.
+ *
+ * Strict subterms are rewritten bottom up, memoising the normal forms of the
+ * shared subterms. The arguments of equalities that need the redundancy check
+ * are rewritten at the top afterwards, checking each step against the clause
+ * as rewritten so far, so that the result is also reached by a sequence of
+ * single forward demodulations.
+ */
+bool ForwardDemodulation::performNormalForm(Clause* cl, Clause*& replacement, ClauseIterator& premises)
+{
+  TIME_TRACE("forward demodulation");
+
+  NormalForm& nf = _nf;
+  nf.reset(cl);
+
+  for (unsigned li = 0; li < nf.lits.size(); li++) {
+    Literal* lit = nf.lits[li];
+    if (lit->isAnswerLiteral()) {
+      continue;
+    }
+    if (_skipNonequationalLiterals && !lit->isEquality()) {
+      continue;
+    }
+    unsigned steps = nf.steps;
+
+    bool redundancyCheck = lit->isEquality() && _helper.redundancyCheckNeededForPremise(nf.lits, lit, *lit->nthArgument(0));
+    RStack<TermList> args;
+    for (unsigned i = 0; i < lit->arity(); i++) {
+      TermList arg = *lit->nthArgument(i);
+      if (i < lit->numTypeArguments() || arg.isVar()) {
+        args->push(arg);
+        continue;
+      }
+      TypedTermList targ(arg, lit->isEquality() ? SortHelper::getEqualityArgumentSort(lit) : SortHelper::getArgSort(lit, i));
+      args->push(redundancyCheck ? normaliseArgs(targ) : normalise(targ));
+    }
+    if (nf.steps != steps) {
+      lit = lit->isEquality()
+        ? Literal::createEquality(lit->polarity(), (*args)[0], (*args)[1], SortHelper::getEqualityArgumentSort(lit))
+        : Literal::create(lit, args->begin());
+      nf.lits[li] = lit;
+    }
+
+    if (redundancyCheck) {
+      TermList sort = SortHelper::getEqualityArgumentSort(lit);
+      for (unsigned side = 0; side < 2; side++) {
+        TermList rhs;
+        while (lit->nthArgument(side)->isTerm() && rewriteInNormalForm(lit, TypedTermList(*lit->nthArgument(side), sort), /* redundancyCheck */ true, rhs)) {
+          (*args)[side] = normaliseArgs(TypedTermList(rhs, sort));
+          lit = Literal::createEquality(lit->polarity(), (*args)[0], (*args)[1], sort);
+          nf.lits[li] = lit;
+        }
+      }
+    }
+
+    if (nf.steps != steps && EqHelper::isEqTautology(lit)) {
+      env.statistics->forwardDemodulationsToEqTaut++;
+      premises = getPersistentIterator(ClauseStack::Iterator(nf.premises));
+      return true;
+    }
+  }
+
+  if (nf.steps == 0) {
+    return false;
+  }
+
+  env.statistics->forwardDemodulations += nf.steps;
+
+  UnitList* prems = UnitList::empty();
+  UnitList::pushFromIterator(ClauseStack::Iterator(nf.premises), prems);
+  UnitList::push(cl, prems);
+
+  premises = getPersistentIterator(ClauseStack::Iterator(nf.premises));
+  replacement = Clause::fromStack(nf.lits, SimplifyingInferenceMany(InferenceRule::FORWARD_DEMODULATION, prems));
+  // the proof extra describes a single rewrite
+  if (env.options->proofExtra() == Options::ProofExtra::FULL && nf.steps == 1) {
+    env.proofExtra.insert(replacement, new ForwardDemodulationExtra(nf.lastDemodulator->term, nf.lastTarget));
+  }
+  return true;
+}
+
 template <bool combinatorySupSupport>
 bool ForwardDemodulationImpl<combinatorySupSupport>::perform(Clause* cl, Clause*& replacement, ClauseIterator& premises)
 {
-  TIME_TRACE("forward demodulation");
+  if constexpr (!combinatorySupSupport) {
+    if (_normalForm) {
+      return performNormalForm(cl, replacement, premises);
+    }
+  }
 
-  Ordering& ordering = _salg->getOrdering();
+  TIME_TRACE("forward demodulation");
 
   //Perhaps it might be a good idea to try to
   //replace subterms in some special order, like
@@ -134,100 +439,36 @@ bool ForwardDemodulationImpl<combinatorySupSupport>::perform(Clause* cl, Clause*
 
       bool redundancyCheck = _helper.redundancyCheckNeededForPremise(cl, lit, trm);
 
-      auto git = _index->getGeneralizations(trm.term(), /* retrieveSubstitutions */ true);
-      while(git.hasNext()) {
-        auto qr=git.next();
-        ASS_EQ(qr.data->clause->length(),1);
-
-        if(!ColorHelper::compatible(cl->color(), qr.data->clause->color())) {
-          continue;
-        }
-
-        auto lhs = qr.data->term;
-
-        // TODO:
-        // to deal with polymorphic matching
-        // Ideally, we would like to extend the substitution
-        // returned by the index to carry out the sort match.
-        // However, ForwardDemodulation uses a CodeTree as its
-        // indexing mechanism, and it is not clear how to extend
-        // the substitution returned by a code tree.
-        static RobSubstitution eqSortSubs;
-        if(lhs.isVar()){
-          eqSortSubs.reset();
-          TermList querySort = trm.sort();
-          TermList eqSort = qr.data->term.sort();
-          if(!eqSortSubs.match(eqSort, 0, querySort, 1)){
-            continue;
-          }
-        }
-
-        TermList rhs = qr.data->rhs;
-        bool preordered = qr.data->preordered;
-
-        auto subs = qr.unifier;
-        ASS(subs->isIdentityOnQueryWhenResultBound());
-
-        ApplicatorWithEqSort applWithEqSort(subs.ptr(), eqSortSubs);
-        Applicator applWithoutEqSort(subs.ptr());
-        auto appl = lhs.isVar() ? (SubstApplicator*)&applWithEqSort : (SubstApplicator*)&applWithoutEqSort;
-
-        if (_precompiledComparison) {
-          if (!preordered && (_preorderedOnly || !qr.data->comparator->check(appl))) {
-            continue;
-          }
-        } else {
-          if (!preordered && (_preorderedOnly || !ordering.isGreater(AppliedTerm(trm),AppliedTerm(rhs,appl,true)))) {
-            continue;
-          }
-        }
-
-        // encompassing demodulation is fine when rewriting the smaller guy
-        if (redundancyCheck && _encompassing) {
-          // this will only run at most once;
-          // could have been factored out of the getGeneralizations loop,
-          // but then it would run exactly once there
-          Ordering::Result litOrder = ordering.getEqualityArgumentOrder(lit);
-          if ((trm==*lit->nthArgument(0) && litOrder == Ordering::LESS) ||
-              (trm==*lit->nthArgument(1) && litOrder == Ordering::GREATER)) {
-            redundancyCheck = false;
-          }
-        }
-
-        TermList rhsS = subs->applyToBoundResult(rhs);
-        if (lhs.isVar()) {
-          rhsS = eqSortSubs.apply(rhsS, 0);
-        }
-
-        if (redundancyCheck && !_helper.isPremiseRedundant(cl, lit, trm, rhsS, lhs, appl)) {
-          continue;
-        }
+      TermList rhsS;
+      const DemodulatorData* demodulator;
+      if (!rewrite(cl->color(), cl, lit, trm, redundancyCheck, rhsS, demodulator)) {
+        continue;
+      }
 
-        Literal* resLit = EqHelper::replace(lit,trm,rhsS);
-        if(EqHelper::isEqTautology(resLit)) {
-          env.statistics->forwardDemodulationsToEqTaut++;
-          premises = pvi( getSingletonIterator(qr.data->clause));
-          return true;
-        }
+      Literal* resLit = EqHelper::replace(lit,trm,rhsS);
+      if(EqHelper::isEqTautology(resLit)) {
+        env.statistics->forwardDemodulationsToEqTaut++;
+        premises = pvi( getSingletonIterator(demodulator->clause));
+        return true;
+      }
 
-        RStack<Literal*> resLits;
-        resLits->push(resLit);
+      RStack<Literal*> resLits;
+      resLits->push(resLit);
 
-        for(unsigned i=0;i<cLen;i++) {
-          Literal* curr=(*cl)[i];
-          if(curr!=lit) {
-            resLits->push(curr);
-          }
+      for(unsigned i=0;i<cLen;i++) {
+        Literal* curr=(*cl)[i];
+        if(curr!=lit) {
+          resLits->push(curr);
         }
+      }
 
-        env.statistics->forwardDemodulations++;
+      env.statistics->forwardDemodulations++;
 
-        premises = pvi( getSingletonIterator(qr.data->clause));
-        replacement = Clause::fromStack(*resLits, SimplifyingInference2(InferenceRule::FORWARD_DEMODULATION, cl, qr.data->clause));
-        if(env.options->proofExtra() == Options::ProofExtra::FULL)
-          env.proofExtra.insert(replacement, new ForwardDemodulationExtra(lhs, trm));
-        return true;
-      }
+      premises = pvi( getSingletonIterator(demodulator->clause));
+      replacement = Clause::fromStack(*resLits, SimplifyingInference2(InferenceRule::FORWARD_DEMODULATION, cl, demodulator->clause));
+      if(env.options->proofExtra() == Options::ProofExtra::FULL)
+        env.proofExtra.insert(replacement, new ForwardDemodulationExtra(demodulator->term, trm));
+      return true;
     }
   }
 
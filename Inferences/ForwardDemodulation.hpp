@@ -17,7 +17,12 @@
 #define __ForwardDemodulation__
 
 #include "Forwards.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Option.hpp"
+#include "Lib/Stack.hpp"
 #include "Indexing/TermIndex.hpp"
+#include "Indexing/TermSharing.hpp"
 
 #include "DemodulationHelper.hpp"
 #include "InferenceEngine.hpp"
@@ -37,13 +42,104 @@ public:
   void attach(SaturationAlgorithm* salg) override;
   void detach() override;
   bool perform(Clause* cl, Clause*& replacement, ClauseIterator& premises) override = 0;
+#if VDEBUG
+  /** to be called after InferenceEngine::attach(), which skips the index manager */
+  void setTestIndices(const Stack<Index*>& indices) override
+  {
+    _index = static_cast<DemodulationLHSIndex*>(indices[0]);
+    readOptions();
+  }
+#endif // VDEBUG
 protected:
+  template<class Lits>
+  bool rewrite(Color color, const Lits& lits, Literal* lit, TypedTermList trm, bool redundancyCheck,
+    TermList& res, const DemodulatorData*& demodulator);
+  bool performNormalForm(Clause* cl, Clause*& replacement, ClauseIterator& premises);
+
   bool _preorderedOnly;
   bool _encompassing;
   bool _precompiledComparison;
   bool _skipNonequationalLiterals;
+  bool _normalForm;
   DemodulationHelper _helper;
   DemodulationLHSIndex* _index;
+
+private:
+  void readOptions();
+  TermList normalise(TypedTermList t);
+  TermList normaliseArgs(TypedTermList t);
+  bool rewriteInNormalForm(Literal* lit, TypedTermList trm, bool redundancyCheck, TermList& res);
+
+  bool isIrreducible(Term* t);
+  void setIrreducible(Term* t);
+
+  /**
+   * Terms that none of the demodulators in the index can rewrite, whatever
+   * the clause they occur in. Removing demodulators cannot make them
+   * reducible, so they are valid until the next demodulator is added,
+   * which is detected by comparing the count of Index::additions().
+   */
+  struct IrreducibleTerms
+  : public TermRoot
+  {
+    void markTerms() const override;
+
+    unsigned long additions = 0;
+    DHSet<Term*> terms;
+  } _irreducible;
+
+  /**
+   * The state of rewriting a clause to its normal form in performNormalForm(),
+   * kept between the calls so that its containers are reused
+   */
+  struct NormalForm
+  {
+    /** memoisation of the normal forms of shared subterms for BottomUpEvaluation */
+    struct Memo {
+      Option<TermList> get(TypedTermList t)
+      {
+        TermList* res = normalForms.findPtr(t.term());
+        return res ? Option<TermList>(*res) : Option<TermList>();
+      }
+
+      template<class Init>
+      TermList getOrInit(TypedTermList t, Init init)
+      {
+        if (TermList* res = normalForms.findPtr(t.term())) {
+          return *res;
+        }
+        // computing the normal form may memoise other terms, so we cannot keep a pointer into the map
+        TermList res = init();
+        normalForms.insert(t.term(), res);
+        return res;
+      }
+
+      DHMap<Term*, TermList> normalForms;
+    };
+
+    void reset(Clause* c)
+    {
+      cl = c;
+      lits.reset();
+      lits.loadFromIterator(c->iterLits());
+      memo.normalForms.reset();
+      premises.reset();
+      premiseSet.reset();
+      steps = 0;
+    }
+
+    Clause* cl;
+    /** the literals of the clause rewritten so far */
+    LiteralStack lits;
+    Memo memo;
+    /** the demodulators used, each of them once */
+    ClauseStack premises;
+    DHSet<Clause*> premiseSet;
+    unsigned steps;
+    /** the demodulator and the term rewritten by the last step, for the proof extra */
+    const DemodulatorData* lastDemodulator;
+    TermList lastTarget;
+  } _nf;
 };
 
 template <bool combinatorySupSupport>
@@ -52,6 +52,11 @@ void ForwardSubsumptionAndResolution::attach(SaturationAlgorithm *salg)
       _salg->getIndexManager()->request(FW_SUBSUMPTION_UNIT_CLAUSE_SUBST_TREE));
   _fwIndex = static_cast<FwSubsSimplifyingLiteralIndex *>(
       _salg->getIndexManager()->request(FW_SUBSUMPTION_SUBST_TREE));
+  _fvIndex = nullptr;
+  if (getOptions().featureVectorSubsumption()) {
+    _fvIndex = static_cast<FeatureVectorIndex *>(
+        _salg->getIndexManager()->request(SUBSUMPTION_FEATURE_VECTOR_INDEX));
+  }
 }
 
 void ForwardSubsumptionAndResolution::detach()
@@ -60,6 +65,10 @@ void ForwardSubsumptionAndResolution::detach()
   _fwIndex = 0;
   _salg->getIndexManager()->release(FW_SUBSUMPTION_UNIT_CLAUSE_SUBST_TREE);
   _salg->getIndexManager()->release(FW_SUBSUMPTION_SUBST_TREE);
+  if (_fvIndex) {
+    _fvIndex = 0;
+    _salg->getIndexManager()->release(SUBSUMPTION_FEATURE_VECTOR_INDEX);
+  }
   ForwardSimplificationEngine::detach();
 }
 
@@ -108,6 +117,28 @@ bool ForwardSubsumptionAndResolution::perform(Clause *cl,
     }
   }
 
+  /*******************************************************/
+  /*      SUBSUMPTION MULTI-LITERAL (FEATURE VECTORS)    */
+  /*******************************************************/
+  // The feature vector index only returns clauses not longer than cl, and
+  // each of them once. Unit clauses were already checked above.
+  // Subsumption resolution does not preserve features, so it is left to the
+  // literal index below.
+  if (_fvIndex) {
+    auto it = _fvIndex->getSubsumingCandidates(cl);
+    while (it.hasNext()) {
+      mcl = it.next();
+      if (mcl->length() == 1) {
+        continue;
+      }
+      if (satSubs.checkSubsumption(mcl, cl, false)) {
+        premises = pvi(getSingletonIterator(mcl));
+        env.statistics->forwardSubsumed++;
+        return true;
+      }
+    }
+  }
+
   /*******************************************************/
   /*       SUBSUMPTION & RESOLUTION MULTI-LITERAL        */
   /*******************************************************/
@@ -120,7 +151,7 @@ bool ForwardSubsumptionAndResolution::perform(Clause *cl,
   // keep it until the end of the loop to make sure no subsumption is possible.
   // Only when it has been checked that subsumption is not possible does the conclusion of
   // subsumption resolution become relevant
-  for (unsigned li = 0; li < clen; li++) {
+  for (unsigned li = 0; li < clen && (!_fvIndex || _subsumptionResolution); li++) {
     Literal *lit = (*cl)[li];
     auto it = _fwIndex->getGeneralizations(lit, false, false);
     while (it.hasNext()) {
@@ -133,7 +164,7 @@ bool ForwardSubsumptionAndResolution::perform(Clause *cl,
                     (_checkLongerClauses || mcl->length() <= clen);
 
       // if mcl is longer than cl, then it cannot subsume cl but still could be resolved
-      bool checkS = mcl->length() <= clen;
+      bool checkS = !_fvIndex && mcl->length() <= clen;
       if (checkS) {
         if (satSubs.checkSubsumption(mcl, cl, checkSR)) {
           ASS(replacement == nullptr)
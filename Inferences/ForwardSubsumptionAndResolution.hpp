@@ -19,6 +19,7 @@
 #include "SATSubsumption/SATSubsumptionAndResolution.hpp"
 #include "Indexing/LiteralMiniIndex.hpp"
 #include "Indexing/LiteralIndex.hpp"
+#include "Indexing/FeatureVectorIndex.hpp"
 
 namespace Inferences {
 class ForwardSubsumptionAndResolution
@@ -58,6 +59,8 @@ private:
   Indexing::UnitClauseLiteralIndex *_unitIndex;
   /// @brief Forward index containing the clauses with which the inference engine can perform forward subsumption and resolution
   Indexing::FwSubsSimplifyingLiteralIndex *_fwIndex;
+  /// @brief Index of subsumption candidates if option feature_vector_subsumption is on, null otherwise
+  Indexing::FeatureVectorIndex *_fvIndex;
 
   /// @brief Parameter to enable or disable subsumption resolution
   /// @note If the parameter is set to false, then the inference engine will only perform forward subsumption
@@ -20,6 +20,7 @@
 
 #include "Lib/Allocator.hpp"
 #include "Lib/DArray.hpp"
+#include "Lib/DHSet.hpp"
 #include "Debug/Output.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
@@ -61,6 +62,7 @@ size_t Clause::_auxCurrTimestamp = 0;
 #if VDEBUG
 bool Clause::_auxInUse = false;
 #endif
+DHSet<Clause*>* Clause::_liveClauses = nullptr;
 
 /** New clause */
 Clause::Clause(Literal* const* lits, unsigned length, Inference inf)
@@ -90,6 +92,9 @@ Clause::Clause(Literal* const* lits, unsigned length, Inference inf)
   for(unsigned i = 0; i < length; i++) {
     (*this)[i] = lits[i];
   }
+  if (_liveClauses) {
+    _liveClauses->insert(this);
+  }
 
 #if VAMPIRE_CLAUSE_TRACING
   // TODO make unsigned
@@ -160,6 +165,9 @@ void Clause::destroyExceptInferenceObject()
   }
 
   ConditionalRedundancyHandler::destroyClauseData(this);
+  if (_liveClauses) {
+    _liveClauses->remove(this);
+  }
 
   RSTAT_CTR_INC("clauses deleted");
 
@@ -173,6 +181,18 @@ void Clause::destroyExceptInferenceObject()
 }
 
 
+void Clause::trackLiveClauses(bool track)
+{
+  if (!track) {
+    delete _liveClauses;
+    _liveClauses = nullptr;
+  } else if (!_liveClauses) {
+    // the clauses already in existence are not known, which is fine
+    // as long as they do not contain any literals the caller is interested in
+    _liveClauses = new DHSet<Clause*>();
+  }
+}
+
 /**
  * Create a clause with the same content as @c c. The inference of the
  * created clause refers to @c c using the REORDER_LITERALS inference.
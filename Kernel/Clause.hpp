@@ -134,6 +134,15 @@ public:
 
   void destroy();
   void destroyExceptInferenceObject();
+
+  /**
+   * Start or stop keeping track of the clauses in existence (cf. liveClauses()),
+   * which TermSharing::collect() needs to find the literals still in use
+   */
+  static void trackLiveClauses(bool track);
+  /** The clauses in existence if tracked, otherwise nullptr */
+  static const DHSet<Clause*>* liveClauses() { return _liveClauses; }
+
   std::string literalsOnlyToString() const;
   std::string toString() const;
   std::string toTPTPString() const;
@@ -403,6 +412,9 @@ protected:
   static bool _auxInUse;
 #endif
 
+  /** the clauses in existence, if tracked */
+  static DHSet<Clause*>* _liveClauses;
+
 
   /** Array of literals of this unit */
   Literal* _literals[1];
@@ -863,6 +863,8 @@ std::string Kernel::ruleName(InferenceRule rule)
     return "distinct equality removal";
   case InferenceRule::EXTERNAL:
     return "external";
+  case InferenceRule::PORTFOLIO_IMPORT:
+    return "imported from another slice";
   case InferenceRule::CLAIM_DEFINITION:
     return "claim definition";
   case InferenceRule::FMB_FLATTENING:
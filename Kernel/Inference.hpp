@@ -432,6 +432,8 @@ enum class InferenceRule : unsigned char {
 
   /** inference coming from outside of Vampire */
   EXTERNAL,
+  /** clause derived by another portfolio slice, see Saturation::ClauseExchange */
+  PORTFOLIO_IMPORT,
 
   /* FMB flattening */
   FMB_FLATTENING,
@@ -71,6 +71,15 @@ void InferenceStore::recordSplittingNameLiteral(Unit* us, Literal* lit)
 }
 
 
+/** Mark the splitting name literals, cf. TermSharing::collect() */
+void InferenceStore::markTerms() const
+{
+  DHMap<Unit*, Literal*>::Iterator it(_splittingNameLiterals);
+  while (it.hasNext()) {
+    env.sharing->mark(it.next());
+  }
+}
+
 /**
  * Record the introduction of a new symbol
  */
@@ -29,16 +29,20 @@
 #include "Kernel/Signature.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/Inference.hpp"
+#include "Indexing/TermSharing.hpp"
 
 namespace Kernel {
 
 using namespace Lib;
 
 class InferenceStore
+  : public Indexing::TermRoot
 {
 public:
   static InferenceStore* instance();
 
+  void markTerms() const override;
+
   typedef List<int> IntList;
 
   struct FullInference
@@ -21,6 +21,7 @@
 #include "Shell/Options.hpp"
 #include <fstream>
 
+#include "FlatTerm.hpp"
 #include "KBOComparator.hpp"
 #include "NumTraits.hpp"
 #include "Signature.hpp"
@@ -704,6 +705,7 @@ KBO::KBO(Problem& prb, const Options& opts)
   if (opts.kboMaxZero()) {
     zeroWeightForMaximalFunc();
   }
+  _flatComparison = opts.kboFlatComparison();
 
   if (opts.kboAdmissabilityCheck() == Options::KboAdmissibilityCheck::ERROR)
     checkAdmissibility(throwError);
@@ -714,6 +716,11 @@ KBO::KBO(Problem& prb, const Options& opts)
 KBO::~KBO()
 {
   delete _state;
+  for (auto& f : _flattened) {
+    if (f.flat) {
+      f.flat->destroy();
+    }
+  }
 }
 
 /**
@@ -764,7 +771,152 @@ Ordering::Result KBO::comparePredicates(Literal* l1, Literal* l2) const
 
 Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
 {
-  return compare(AppliedTerm(tl1),AppliedTerm(tl2));
+  return cached(tl1, tl2, [&]() {
+    if (_flatComparison && tl1.isTerm() && tl2.isTerm() && tl1.term()->shared() && tl2.term()->shared()) {
+      return compareFlat(tl1.term(), tl2.term());
+    }
+    return compare(AppliedTerm(tl1),AppliedTerm(tl2));
+  });
+}
+
+/**
+ * Compare @b t1 and @b t2 over their flattenings, cf. FlatTerm. Unlike
+ * State, which counts variables in a hash map during a recursive traversal,
+ * this scans the contiguous entries of the flat terms for variables and
+ * balances them in the dense array @b _flatVarDiffs, whose sign checks are
+ * then a simple loop the compiler can vectorise.
+ */
+Ordering::Result KBO::compareFlat(Term* t1, Term* t2) const
+{
+  if (t1 == t2) {
+    return EQUAL;
+  }
+  return compareFlat(flatten(t1, 0), 0, flatten(t2, 1), 0);
+}
+
+/**
+ * Return the flattening of the shared term @b t, reusing the last one made
+ * for @b side, as one term is often compared with many others.
+ */
+const FlatTerm& KBO::flatten(Term* t, unsigned side) const
+{
+  ASS(t->shared());
+  auto& f = _flattened[side];
+  if (f.term != t || f.id != t->getId()) {
+    if (f.flat) {
+      f.flat->destroy();
+    }
+    f.term = t;
+    f.id = t->getId();
+    f.flat = FlatTerm::create(t);
+  }
+  return *f.flat;
+}
+
+/**
+ * Compare the subterms at positions @b p1 of @b ft1 and @b p2 of @b ft2.
+ * Equal weights and top symbols are resolved by comparing the first pair
+ * of different arguments recursively, which together with the variable
+ * condition on the whole terms is the original definition of KBO.
+ */
+Ordering::Result KBO::compareFlat(const FlatTerm& ft1, size_t p1, const FlatTerm& ft2, size_t p2) const
+{
+  // number of entries of the subterm at position p
+  auto length = [](const FlatTerm& ft, size_t p) -> size_t {
+    return ft[p].isVar() ? 1 : ft[p+2]._number();
+  };
+  auto containsVar = [&](const FlatTerm& ft, size_t p, unsigned var) {
+    for (size_t i = p; i < p + length(ft, p); i++) {
+      if (ft[i].isVar(var)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if (ft1[p1].isVar()) {
+    if (ft2[p2].isVar(ft1[p1]._number())) {
+      return EQUAL;
+    }
+    return containsVar(ft2, p2, ft1[p1]._number()) ? LESS : INCOMPARABLE;
+  }
+  if (ft2[p2].isVar()) {
+    return containsVar(ft1, p1, ft2[p2]._number()) ? GREATER : INCOMPARABLE;
+  }
+  Term* t1 = ft1[p1+1]._term();
+  Term* t2 = ft2[p2+1]._term();
+  if (t1 == t2) {
+    return EQUAL;
+  }
+
+  // balance the weights and the variables in one scan over the entries
+  int weightDiff = 0;
+  unsigned maxVar = 0;
+  auto record = [&](const FlatTerm& ft, size_t p, int coef) {
+    size_t end = p + length(ft, p);
+    for (size_t i = p; i < end;) {
+      if (ft[i].isVar()) {
+        unsigned var = ft[i]._number();
+        if (var >= _flatVarDiffs.size()) {
+          _flatVarDiffs.expand(2 * var + 1, 0);
+        }
+        _flatVarDiffs[var] += coef;
+        maxVar = std::max(maxVar, var + 1);
+        weightDiff += coef * (int)_funcWeights._specialWeights._variableWeight;
+        i++;
+      } else {
+        weightDiff += coef * symbolWeight(ft[i+1]._term());
+        i += FlatTerm::FUNCTION_ENTRY_COUNT;
+      }
+    }
+  };
+  record(ft1, p1, 1);
+  record(ft2, p2, -1);
+
+  // variables occurring more times in t1 and in t2, respectively
+  unsigned posNum = 0;
+  unsigned negNum = 0;
+  int* diffs = _flatVarDiffs.array();
+  for (unsigned v = 0; v < maxVar; v++) {
+    posNum += diffs[v] > 0;
+    negNum += diffs[v] < 0;
+  }
+  std::fill(diffs, diffs + maxVar, 0);
+
+  auto withVariableCondition = [&](Result res) {
+    if (res == GREATER) {
+      return negNum ? INCOMPARABLE : GREATER;
+    }
+    if (res == LESS) {
+      return posNum ? INCOMPARABLE : LESS;
+    }
+    return res;
+  };
+
+  if (weightDiff) {
+    return withVariableCondition(weightDiff > 0 ? GREATER : LESS);
+  }
+
+  Result prec = t1->isSort()
+    ? compareTypeConPrecedences(t1->functor(),t2->functor())
+    : compareFunctionPrecedences(t1->functor(),t2->functor());
+  if (prec != EQUAL) {
+    return withVariableCondition(prec);
+  }
+
+  // the first pair of different arguments decides
+  size_t a1 = p1 + FlatTerm::FUNCTION_ENTRY_COUNT;
+  size_t a2 = p2 + FlatTerm::FUNCTION_ENTRY_COUNT;
+  for (unsigned i = 0; i < t1->arity(); i++) {
+    TermList arg1 = *t1->nthArgument(i);
+    TermList arg2 = *t2->nthArgument(i);
+    if (arg1 != arg2) {
+      return withVariableCondition(compareFlat(ft1, a1, ft2, a2));
+    }
+    a1 += length(ft1, a1);
+    a2 += length(ft2, a2);
+  }
+  ASSERTION_VIOLATION;
 }
 
 Ordering::Result KBO::compare(AppliedTerm tl1, AppliedTerm tl2) const
@@ -884,6 +1036,14 @@ OrderingComparatorUP KBO::createComparator(TermList lhs, TermList rhs) const
   return make_unique<KBOComparator>(lhs, rhs, *this);
 }
 
+OrderingComparatorUP KBO::createComparator(TermList lhs, TermList rhs, OrderingComparator::SharedSP& shared) const
+{
+  if (!shared) {
+    shared = make_shared<KBOComparator::Instances>(lhs);
+  }
+  return make_unique<KBOComparator>(lhs, rhs, *this, static_pointer_cast<KBOComparator::Instances>(shared));
+}
+
 int KBO::symbolWeight(const Term* t) const
 {
 #if __KBO__CUSTOM_PREDICATE_WEIGHTS__
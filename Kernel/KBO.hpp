@@ -159,6 +159,10 @@ public:
   Result compare(AppliedTerm t1, AppliedTerm t2) const override;
   bool isGreater(AppliedTerm t1, AppliedTerm t2) const override;
   OrderingComparatorUP createComparator(TermList lhs, TermList rhs) const override;
+  OrderingComparatorUP createComparator(TermList lhs, TermList rhs, OrderingComparator::SharedSP& shared) const override;
+
+  /** Compare non-variable terms by compareFlat() rather than by State, cf. the kbo_flat_comparison option */
+  void setFlatComparison(bool flat) { _flatComparison = flat; }
 
 protected:
   Result isGreaterOrEq(AppliedTerm tt1, AppliedTerm tt2) const;
@@ -185,6 +189,24 @@ private:
   template<class SigTraits> 
   void showConcrete_(std::ostream&) const;
 
+  Result compareFlat(Term* t1, Term* t2) const;
+  Result compareFlat(const FlatTerm& ft1, size_t p1, const FlatTerm& ft2, size_t p2) const;
+  const FlatTerm& flatten(Term* t, unsigned side) const;
+
+  bool _flatComparison = false;
+  /** balances of the variables in compareFlat(), indexed by variable and kept zeroed between uses */
+  mutable DArray<int> _flatVarDiffs;
+  /**
+   * The last terms flattened as the first and as the second argument of
+   * compareFlat(), identified by their id as in KBOComparator::Instances.
+   */
+  struct Flattened {
+    Term* term = nullptr;
+    unsigned id = 0;
+    FlatTerm* flat = nullptr;
+  };
+  mutable Flattened _flattened[2];
+
   /**
    * Class to represent the current state of the KBO comparison.
    * Based on Bernd Loechner's "Things to Know when Implementing KBO"
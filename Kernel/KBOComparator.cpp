@@ -20,8 +20,41 @@ using namespace std;
 using namespace Lib;
 using namespace Shell;
 
-KBOComparator::KBOComparator(TermList lhs, TermList rhs, const KBO& kbo)
-  : OrderingComparator(lhs, rhs, kbo)
+KBOComparator::Instances::Instances(TermList lhs)
+{
+  unsigned size = 0;
+  VariableIterator vit(lhs);
+  while (vit.hasNext()) {
+    size = max(size, vit.next().var()+1);
+  }
+  _entries.ensure(size);
+  for (auto& e : _entries) {
+    e.instance = TermList::empty();
+  }
+}
+
+const KBOComparator::Instances::Entry& KBOComparator::Instances::get(unsigned var, const SubstApplicator* applicator, const KBO& kbo)
+{
+  AppliedTerm tt(TermList::var(var), applicator, true);
+  bool cached = var < _entries.size() && (tt.term.isVar() || tt.term.term()->shared());
+  auto& e = cached ? _entries[var] : _uncached;
+
+  if (cached && e.instance == tt.term && (tt.term.isVar() || e.id == tt.term.term()->getId())) {
+    return e;
+  }
+  e.instance = tt.term;
+  e.id = tt.term.isVar() ? 0 : tt.term.term()->getId();
+  e.weight = kbo.computeWeight(tt);
+  e.vars.reset();
+  VariableIterator vit(tt.term);
+  while (vit.hasNext()) {
+    e.vars.push(vit.next().var());
+  }
+  return e;
+}
+
+KBOComparator::KBOComparator(TermList lhs, TermList rhs, const KBO& kbo, std::shared_ptr<Instances> instances)
+  : OrderingComparator(lhs, rhs, kbo), _instances(instances ? std::move(instances) : make_shared<Instances>(lhs))
 {
 }
 
@@ -192,20 +225,17 @@ bool KBOComparator::check(const SubstApplicator* applicator)
 
           auto var = _instructions[j]._firstUint();
           auto coeff = _instructions[j]._coeff();
-          AppliedTerm tt(TermList::var(var), applicator, true);
+          const auto& inst = _instances->get(var, applicator, kbo);
 
-          VariableIterator vit(tt.term);
-          while (vit.hasNext()) {
-            auto v = vit.next();
-            varDiffs[v.var()] += coeff;
+          for (unsigned v : inst.vars) {
+            varDiffs[v] += coeff;
             // since the counts are sorted in descending order,
             // this can only mean we will fail
-            if (varDiffs[v.var()]<0) {
+            if (varDiffs[v]<0) {
               return false;
             }
           }
-          auto w = kbo.computeWeight(tt);
-          weight += coeff*w;
+          weight += coeff*inst.weight;
           // due to descending order of counts,
           // this also means failure
           if (coeff<0 && weight<0) {
@@ -17,6 +17,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DArray.hpp"
 #include "Lib/Stack.hpp"
 
 #include "KBO.hpp"
@@ -33,7 +34,37 @@ class KBOComparator
 : public OrderingComparator
 {
 public:
-  KBOComparator(TermList lhs, TermList rhs, const KBO& kbo);
+  /**
+   * The weights and variables of the instances of the variables of a
+   * left-hand side, shared by the comparators of its right-hand sides.
+   * Each variable remembers the last instance it was computed for, which
+   * is identified by the unique id of the shared term, so that a term
+   * allocated in place of a collected one is not mistaken for it.
+   */
+  class Instances
+  : public OrderingComparator::Shared
+  {
+  public:
+    Instances(TermList lhs);
+
+    struct Entry {
+      TermList instance;
+      unsigned id;
+      unsigned weight;
+      /** variables of the instance, with repetitions */
+      Stack<unsigned> vars;
+    };
+
+    /** Return the entry of the instance of @b var by @b applicator */
+    const Entry& get(unsigned var, const SubstApplicator* applicator, const KBO& kbo);
+
+  private:
+    DArray<Entry> _entries;
+    /** for variables not occurring in the left-hand side or instances that are not shared */
+    Entry _uncached;
+  };
+
+  KBOComparator(TermList lhs, TermList rhs, const KBO& kbo, std::shared_ptr<Instances> instances = nullptr);
 
   /** Executes the runtime specialized instructions with concrete substitution. */
   bool check(const SubstApplicator* applicator) override;
@@ -113,6 +144,7 @@ private:
   };
   bool _ready = false;
   Stack<Instruction> _instructions;
+  std::shared_ptr<Instances> _instances;
 };
 
 }
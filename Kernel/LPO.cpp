@@ -81,7 +81,7 @@ Ordering::Result LPO::comparePrecedences(const Term* t1, const Term* t2) const
 
 Ordering::Result LPO::compare(TermList tl1, TermList tl2) const
 {
-  return compare(AppliedTerm(tl1),AppliedTerm(tl2));
+  return cached(tl1, tl2, [&]() { return compare(AppliedTerm(tl1),AppliedTerm(tl2)); });
 }
 
 Ordering::Result LPO::compare(AppliedTerm tl1, AppliedTerm tl2) const
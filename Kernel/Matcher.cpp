@@ -232,7 +232,7 @@ bool MatchingUtils::matchTerms(TermList base, TermList instance)
       if(bt->ground()) {
         return bt==it;
       }
-      if(bt->weight() > it->weight()) {
+      if(!bt->mayGeneralize(it)) {
         return false;
       }
     }
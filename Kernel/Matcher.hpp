@@ -108,7 +108,7 @@ public:
         if(bt->ground()) {
           return bt==it;
         }
-        if(bt->weight() > it->weight()) {
+        if(!bt->mayGeneralize(it)) {
           return false;
         }
       }
@@ -172,6 +172,9 @@ bool MatchingUtils::matchReversedArgs(Literal* base, Literal* instance, Binder&
   ASS_EQ(base->arity(), 2);
   ASS_EQ(instance->arity(), 2);
 
+  if (base->shared() && instance->shared() && !base->mayGeneralize(instance)) {
+    return false;
+  }
   if (base->isTwoVarEquality()) {
     if (!matchTerms(base->twoVarEqSort(), SortHelper::getEqualityArgumentSort(instance), binder)) {
       return false;
@@ -192,7 +195,7 @@ bool MatchingUtils::matchArgs(Term* base, Term* instance, Binder& binder)
 {
   ASS_EQ(base->functor(),instance->functor());
   if(base->shared() && instance->shared()) {
-    if(base->weight() > instance->weight()) {
+    if(!base->mayGeneralize(instance)) {
       return false;
     }
   }
@@ -235,7 +238,7 @@ bool MatchingUtils::matchArgs(Term* base, Term* instance, Binder& binder)
 	if(bt->term()->ground() && *bt!=*it) {
 	  return false;
 	}
-	if(s->weight() > t->weight()) {
+	if(!s->mayGeneralize(t)) {
 	  return false;
 	}
       }
@@ -228,7 +228,14 @@ Ordering::Result PrecedenceOrdering::compare(Literal* l1, Literal* l2) const
   if (l1 == l2) {
     return EQUAL;
   }
+  if (_cache) {
+    return _cache->get(l1, l2, [&]() { return compareUncached(l1, l2); });
+  }
+  return compareUncached(l1, l2);
+}
 
+Ordering::Result PrecedenceOrdering::compareUncached(Literal* l1, Literal* l2) const
+{
   unsigned p1 = l1->functor();
   unsigned p2 = l2->functor();
 
@@ -648,6 +655,20 @@ PrecedenceOrdering::PrecedenceOrdering(Problem& prb, const Options& opt)
        predPrecFromOpts(prb, opt)))
 {
   ASS_G(_predicates, 0);
+  if (opt.orderingCache()) {
+    enableCache(opt.orderingCache());
+  }
+}
+
+void OrderingCache::markTerms() const
+{
+  for (size_t i = 0; i < _entries.size(); i++) {
+    const Entry& e = _entries[i];
+    if (e.t1) {
+      env.sharing->mark(e.t1);
+      env.sharing->mark(e.t2);
+    }
+  }
 }
 
 static void sortAuxBySymbolPrecedence(DArray<unsigned>& aux, const Options& opt, SymbolType symType) {
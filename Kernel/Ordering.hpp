@@ -27,7 +27,10 @@
 
 #include "Lib/Allocator.hpp"
 #include "Lib/Portability.hpp"
+#include "Lib/Environment.hpp"
 #include "Kernel/SubstHelper.hpp"
+#include "Indexing/TermSharing.hpp"
+#include "Shell/Statistics.hpp"
 
 namespace Kernel {
 
@@ -46,6 +49,19 @@ struct OrderingComparator
   virtual std::string toString() const { return _lhs.toString()+" > "+_rhs.toString(); }
   virtual bool check(const SubstApplicator* applicator);
 
+  /**
+   * Whatever the checks of one left-hand side against different right-hand
+   * sides compute from the substitution alone, cf. Ordering::createComparator().
+   * Matching the left-hand side determines the substitution of its variables,
+   * so the comparators sharing this compute it once per instance of the
+   * left-hand side, e.g. for all demodulators retrieved for one term.
+   */
+  struct Shared
+  {
+    virtual ~Shared() = default;
+  };
+  using SharedSP = std::shared_ptr<Shared>;
+
   TermList _lhs;
   TermList _rhs;
   const Ordering& _ord;
@@ -95,6 +111,12 @@ public:
   virtual OrderingComparatorUP createComparator(TermList lhs, TermList rhs) const
   { return std::make_unique<OrderingComparator>(lhs, rhs, *this); }
 
+  /** Same as above, merged with the other comparators of the left-hand side
+   *  @b lhs through @b shared, which is set by the first of them.
+   *  @see OrderingComparator::Shared. */
+  virtual OrderingComparatorUP createComparator(TermList lhs, TermList rhs, OrderingComparator::SharedSP& shared) const
+  { return createComparator(lhs, rhs); }
+
   virtual void show(std::ostream& out) const = 0;
 
   static bool isGreaterOrEqual(Result r) { return (r == GREATER || r == EQUAL); }
@@ -151,6 +173,56 @@ private:
   static OrderingSP s_globalOrdering;
 }; // class Ordering
 
+/**
+ * A bounded cache of the results of comparing shared terms or literals.
+ * As they are perfectly shared, the result of a comparison is determined
+ * by the pair of pointers, whether the terms are ground or not.
+ *
+ * The cache is a direct-mapped table, so a pair replaces whichever pair
+ * was stored in its slot before. The cached terms are kept alive by the
+ * cache, so that their memory cannot be reused for other terms.
+ */
+class OrderingCache
+: public Indexing::TermRoot
+{
+public:
+  /** Create a cache of 2^@b sizeLog entries */
+  OrderingCache(unsigned sizeLog) : _entries(1u << sizeLog), _mask((1u << sizeLog) - 1) {}
+
+  /**
+   * Return the result of comparing @b t1 and @b t2, computed by @b compare
+   * if it is not cached.
+   */
+  template<class Compare>
+  Ordering::Result get(Term* t1, Term* t2, Compare compare)
+  {
+    Entry& e = _entries[(((size_t)t1 >> 3) * 0x9e3779b1u ^ ((size_t)t2 >> 3)) & _mask];
+    if (e.t1 == t1 && e.t2 == t2) {
+      env.statistics->orderingCacheHits++;
+      return e.result;
+    }
+    env.statistics->orderingCacheMisses++;
+    // the comparison may use the cache itself, so the entry is only filled after it
+    Ordering::Result res = compare();
+    e.t1 = t1;
+    e.t2 = t2;
+    e.result = res;
+    return res;
+  }
+
+  void markTerms() const override;
+
+private:
+  struct Entry {
+    Term* t1 = nullptr;
+    Term* t2 = nullptr;
+    Ordering::Result result;
+  };
+
+  DArray<Entry> _entries;
+  size_t _mask;
+};
+
 // orderings that rely on symbol precedence
 class PrecedenceOrdering
 : public Ordering
@@ -160,6 +232,9 @@ public:
   void show(std::ostream&) const override;
   virtual void showConcrete(std::ostream&) const = 0;
 
+  /** Cache the results of comparisons of shared terms and literals in a table of 2^@b sizeLog entries */
+  void enableCache(unsigned sizeLog) { _cache = std::make_unique<OrderingCache>(sizeLog); }
+
 protected:
   // l1 and l2 are not equalities and have the same predicate
   virtual Result comparePredicates(Literal* l1,Literal* l2) const = 0;
@@ -181,6 +256,16 @@ protected:
   int predicatePrecedence(unsigned pred) const;
   int predicateLevel(unsigned pred) const;
 
+  /** Return @b compare(), cached if the cache is enabled and @b tl1 and @b tl2 are shared terms */
+  template<class Compare>
+  Result cached(TermList tl1, TermList tl2, Compare compare) const
+  {
+    if (!_cache || tl1.isVar() || tl2.isVar() || !tl1.term()->shared() || !tl2.term()->shared()) {
+      return compare();
+    }
+    return _cache->get(tl1.term(), tl2.term(), compare);
+  }
+
   /** number of predicates in the signature at the time the order was created */
   unsigned _predicates;
   /** number of functions in the signature at the time the order was created */
@@ -195,6 +280,12 @@ protected:
   DArray<int> _typeConPrecedences;
 
   bool _reverseLCM;
+
+  /** the cache of comparison results, if enabled */
+  std::unique_ptr<OrderingCache> _cache;
+
+private:
+  Result compareUncached(Literal* l1, Literal* l2) const;
 };
 
 
@@ -1493,6 +1493,7 @@ Literal* Literal::create2(unsigned predicate, bool polarity, TermList arg1, Term
 Term::Term(const Term& t) throw()
   : _functor(t._functor),
     _arity(t._arity),
+    _marked(0),
     _color(COLOR_TRANSPARENT),
     _hasInterpretedConstants(0),
     _isTwoVarEquality(0),
@@ -1501,7 +1502,9 @@ Term::Term(const Term& t) throw()
 #if VDEBUG
     _kboInstance(nullptr),
 #endif
-    _vars(0)
+    _depth(0),
+    _vars(0),
+    _symbols(0)
 {
   ASS(!isSpecial()); //we do not copy special terms
 
@@ -1527,6 +1530,7 @@ AtomicSort::AtomicSort(const AtomicSort& p) throw()
 Term::Term() throw()
   :_functor(0),
    _arity(0),
+   _marked(0),
    _color(COLOR_TRANSPARENT),
    _hasInterpretedConstants(0),
    _isTwoVarEquality(0),
@@ -1536,7 +1540,9 @@ Term::Term() throw()
    _kboInstance(nullptr),
 #endif
    _maxRedLen(0),
-   _vars(0)
+   _depth(0),
+   _vars(0),
+   _symbols(0)
 {
   _args[0].setContent(0);
   _args[0]._setTag(FUN);
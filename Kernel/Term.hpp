@@ -709,6 +709,13 @@ public:
     _args[0]._setShared(true);
   } // markShared
 
+  /** Mark shared term as no longer shared, before TermSharing::collect() destroys it */
+  void markUnshared()
+  {
+    ASS(shared());
+    _args[0]._setShared(false);
+  } // markUnshared
+
   /** Set term weight */
   void setWeight(unsigned w)
   {
@@ -718,6 +725,47 @@ public:
   /** Set term id */
   void setId(unsigned id);
 
+  /** Return the depth. Applicable only to shared terms */
+  unsigned depth() const
+  {
+    ASS(shared());
+    return _depth;
+  }
+
+  void setDepth(unsigned d)
+  {
+    _depth = d;
+  } // setDepth
+
+  /** Return the symbol bitmap. Applicable only to shared terms */
+  uint64_t symbolBitmap() const
+  {
+    ASS(shared());
+    return _symbols;
+  }
+
+  void setSymbolBitmap(uint64_t s)
+  {
+    _symbols = s;
+  } // setSymbolBitmap
+
+  /** The bit of the symbol bitmap that the functor @b f is hashed to */
+  static uint64_t symbolBit(unsigned f)
+  { return uint64_t(1) << (f % 64); }
+
+  /**
+   * False if this term cannot be matched onto the term @b t, i.e.
+   * no substitution maps this term to @b t. A true result is inconclusive.
+   * For literals only the arguments are compared. Both terms must be shared.
+   */
+  bool mayGeneralize(const Term* t) const
+  {
+    ASS(shared());
+    ASS(t->shared());
+    return _weight <= t->_weight && _depth <= t->_depth &&
+      (_symbols & ~t->_symbols) == 0;
+  }
+
   /** Set (shared) term's id */
   unsigned getId() const
   {
@@ -906,7 +954,9 @@ protected:
   /** The number of this symbol in a signature */
   unsigned _functor;
   /** Arity of the symbol */
-  unsigned _arity : 28;
+  unsigned _arity : 27;
+  /** Set on shared terms found reachable by TermSharing::collect() */
+  unsigned _marked : 1;
   /** colour, used in interpolation and symbol elimination */
   unsigned _color : 2;
   /** Equal to 1 if the term/literal contains any interpreted constants */
@@ -924,6 +974,8 @@ protected:
 #endif
   /** length of maximum reduction length */
   int _maxRedLen;
+  /** Depth of the term, where variables have depth 0 and constants depth 1 */
+  unsigned _depth;
   union {
     /** If _isTwoVarEquality is false, this value is valid and contains
      * number of occurrences of variables */
@@ -932,6 +984,8 @@ protected:
      * the sort of the top-level variables */
     TermList _sort;
   };
+  /** Bitmap of the symbols occurring in the term, each hashed to one of 64 bits */
+  uint64_t _symbols;
 
   /** The list of arguments of size type arity + term arity + 1. The first
    *  argument stores the term weight and the mask (the last two bits are 0).
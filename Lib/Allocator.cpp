@@ -18,11 +18,95 @@
 
 #include <cstdio>
 #include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "Allocator.hpp"
 
 #ifndef INDIVIDUAL_ALLOCATIONS
 Lib::SmallObjectAllocator Lib::GLOBAL_SMALL_OBJECT_ALLOCATOR;
+
+// the size of a huge page on x86-64 (and of the arenas, if they are used)
+const size_t HUGE_PAGE = 2097152;
+static bool HUGE_PAGES = false;
+
+void Lib::useHugePages(bool use) {
+  HUGE_PAGES = use;
+}
+
+// map `bytes` of memory aligned to `bytes` (a power of two)
+static char *mapAligned(size_t bytes) {
+  // map twice as much and cut off the misaligned ends
+  void *mapped = mmap(nullptr, 2 * bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(mapped == MAP_FAILED)
+    throw std::bad_alloc();
+
+  char *start = static_cast<char *>(mapped);
+  char *aligned = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(start) + bytes - 1) & ~(uintptr_t)(bytes - 1));
+  if(aligned != start)
+    munmap(start, aligned - start);
+  munmap(aligned + bytes, start + bytes - aligned);
+  return aligned;
+}
+
+void *Lib::allocateAlignedBlock(size_t bytes, Arena &arena) {
+  if(!HUGE_PAGES || bytes >= HUGE_PAGE)
+    return mapAligned(bytes);
+
+  if(arena.next == arena.end) {
+    arena.next = mapAligned(HUGE_PAGE);
+    arena.end = arena.next + HUGE_PAGE;
+#ifdef MADV_HUGEPAGE
+    // only a hint: without transparent huge pages this is just a larger mapping
+    madvise(arena.next, HUGE_PAGE, MADV_HUGEPAGE);
+#endif
+  }
+  // arenas are multiples of blocks, so the blocks stay aligned
+  void *block = arena.next;
+  arena.next += bytes;
+  return block;
+}
+
+void Lib::releaseBlockPages(char *block, size_t bytes) {
+  // the first page holds the block's header
+  static const size_t page = sysconf(_SC_PAGESIZE);
+  if(bytes > page)
+    madvise(block + page, bytes - page, MADV_DONTNEED);
+}
+
+void Lib::reclaimMemory() {
+  GLOBAL_SMALL_OBJECT_ALLOCATOR.reclaim();
+}
+
+size_t Lib::smallObjectMemory() {
+  return GLOBAL_SMALL_OBJECT_ALLOCATOR.memory();
+}
+
+#if ALLOCATOR_TELEMETRY
+static Lib::AllocationCounts *TYPES = nullptr;
+
+Lib::AllocationCounts &Lib::AllocationCounts::ofType(const char *name) {
+  for(AllocationCounts *counts = TYPES; counts; counts = counts->next)
+    if(!std::strcmp(counts->name, name))
+      return *counts;
+
+  // leaked by design, like the allocator's blocks
+  AllocationCounts *counts = new AllocationCounts(name);
+  counts->next = TYPES;
+  TYPES = counts;
+  return *counts;
+}
+
+const Lib::AllocationCounts *Lib::AllocationCounts::types() {
+  return TYPES;
+}
+#endif // ALLOCATOR_TELEMETRY
+#else
+void Lib::useHugePages(bool) {}
+void Lib::reclaimMemory() {}
+size_t Lib::smallObjectMemory() { return 0; }
 #endif
 
 #if __has_include(<sys/resource.h>)
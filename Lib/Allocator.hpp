@@ -21,6 +21,7 @@
 #define __Allocator__
 
 #include <cstddef>
+#include <cstdint>
 #include <new>
 
 #include "Debug/Assertion.hpp"
@@ -35,6 +36,16 @@
 namespace Lib {
 // attempt to set a memory limit for this process by system call
 void setMemoryLimit(size_t bytes);
+
+// back the blocks the small-object allocator gets from now on by (transparent) huge pages
+void useHugePages(bool use);
+
+// return the memory of small-object allocator blocks that became completely free to the system
+// cheap enough to call every now and then, but not after every allocation
+void reclaimMemory();
+
+// the memory of the small-object allocator blocks in use, a cheap estimate of the memory held by terms, clauses, ...
+size_t smallObjectMemory();
 }
 
 #ifdef INDIVIDUAL_ALLOCATIONS
@@ -54,35 +65,130 @@ inline void free(void *pointer, size_t size, size_t align = alignof(std::max_ali
 
 namespace Lib {
 
+#if ALLOCATOR_TELEMETRY
+/*
+ * Allocation telemetry, compiled in by the CMake option ALLOCATOR_TELEMETRY.
+ *
+ * Counts the live and peak allocations (and their bytes) of every size class of the small-object allocator
+ * and of every type allocating from it, either by USE_ALLOCATOR or by ALLOC_KNOWN under a class name.
+ * Cheap enough for release builds: a handful of increments per allocation and no locking.
+ */
+struct AllocationCounts {
+  // the type counted, nullptr for a size class
+  const char *name;
+  size_t live = 0;
+  size_t peak = 0;
+  size_t bytes = 0;
+  size_t peakBytes = 0;
+  // the counts of the next type, see `types()`
+  AllocationCounts *next = nullptr;
+
+  explicit AllocationCounts(const char *name = nullptr) : name(name) {}
+
+  void allocated(size_t size) {
+    if(++live > peak)
+      peak = live;
+    bytes += size;
+    if(bytes > peakBytes)
+      peakBytes = bytes;
+  }
+
+  void freed(size_t size) {
+    ASS_G(live, 0)
+    live--;
+    bytes -= size;
+  }
+
+  // the counts of the type called `name`, created on the first call for that name
+  // looks through all the types, so cache the result (cf. `ALLOCATION_COUNTS`)
+  static AllocationCounts &ofType(const char *name);
+  // the list of the counts of all types allocated so far
+  static const AllocationCounts *types();
+};
+
+// the counts of the type called `name`, looked up only once per call site
+#define ALLOCATION_COUNTS(name) \
+  ([]() -> Lib::AllocationCounts & { static Lib::AllocationCounts &counts = Lib::AllocationCounts::ofType(name); return counts; }())
+#endif // ALLOCATOR_TELEMETRY
+
+/*
+ * With useHugePages, blocks are cut from larger arenas backed by huge pages.
+ * Every allocator has its arena, so that an arena holds chunks of a single size.
+ */
+struct Arena {
+  char *next = nullptr;
+  char *end = nullptr;
+};
+
+// get `bytes` (a power of two and a multiple of the page size) of memory, aligned to `bytes`,
+// from `arena` or directly from the system
+void *allocateAlignedBlock(size_t bytes, Arena &arena);
+// let the system take back the pages of `bytes` at `block`, which may be reused afterwards
+void releaseBlockPages(char *block, size_t bytes);
+
 /*
  * A simple fixed-size allocator.
- * Allocates largish blocks of memory (`COUNT * SIZE` bytes) from the system,
+ * Allocates largish blocks of memory (`BLOCK_BYTES` bytes, aligned to that) from the system,
  * chopping it into smaller fixed-size chunks for fast allocation/deallocation.
  * Chunks are `SIZE` bytes long, aligned to the greatest common divisor of `SIZE` and `alignof(std::max_align_t)`.
  *
- * The allocator never releases memory to the system, instead retaining it in a free list for reallocation.
- * This fits Vampire's generally-growing allocation pattern reasonably well in practice.
+ * Freed memory is retained in per-block free lists for reallocation,
+ * which fits Vampire's generally-growing allocation pattern reasonably well in practice.
+ * Blocks with free chunks are kept in lists by whether they still have live chunks,
+ * so that `reclaim()` can give the pages of blocks that became completely free
+ * (e.g. after much of the search space was deleted) back to the system
+ * without looking at any other block or chunk.
  */
 template<size_t SIZE>
 class FixedSizeAllocator {
-  // number of chunks (of size `SIZE`) to allocate at a time from the system
-  static const size_t COUNT = 1024;
+  // bytes to allocate at a time from the system, a power of two and a multiple of the page size
+  static constexpr size_t BLOCK_BYTES = 1 << 18;
 
   // to allow for a sneaky implementation hack, we cannot allocate anything smaller than sizeof(void *)
   static_assert(SIZE >= sizeof(void *), "need to store void * in the allocation to keep the free list");
 
-  // An allocated block of memory from the system
-  struct Block {
-    /**
-     * The block allocated from the system, that we chop up into little bits.
-     * Leaked by design to clean up quickly at program exit.
-     * NB: if deleted, must happen _after_ all its allocations are freed - tricky for the global allocator!
+  /*
+   * Stored at the start of every block, found by masking the address of any chunk in it.
+   *
+   * Blocks are leaked by design to clean up quickly at program exit,
+   * although released blocks do not occupy physical memory until they are reused.
+   */
+  struct Header {
+    // chunks handed out and not freed yet
+    size_t live;
+    /*
+     * The free list of this block.
      *
-     * TODO if we want to use Valgrind or similar tools, this will be reported as leaked.
-     * This can be fixed by either
-     * 1. Calling the system allocator if `RUNNING_ON_VALGRIND`, see https://valgrind.org/docs/manual/manual-core-adv.html
-     * 2. Cleaning up after ourselves. This works but is hazardous and less fine-grained, prefer (1) if possible.
-     **/
+     * This uses the chunks themselves to store the free list.
+     * If `ptr` is freed, then `free` is updated to point to `ptr`,
+     * while `*ptr` points to the previous value of `free`.
+     */
+    void **free;
+    // neighbours in the list of blocks in the same state
+    Header *prev;
+    Header *next;
+    enum State {
+      // no free chunks, in no list
+      FULL,
+      // free and live chunks, in `partial`
+      PARTIAL,
+      // free chunks only, in `empty`
+      EMPTY,
+      // pages given back to the system, in `released` waiting to be reused
+      RELEASED
+    } state;
+  };
+
+  // chunks start after the header, rounded up to a multiple of `SIZE` to keep their alignment
+  static constexpr size_t FIRST_CHUNK = SIZE * ((sizeof(Header) + SIZE - 1) / SIZE);
+  static_assert(FIRST_CHUNK + SIZE <= BLOCK_BYTES, "a block must hold at least one chunk");
+
+  static Header *headerOf(void *chunk) {
+    return reinterpret_cast<Header *>(reinterpret_cast<uintptr_t>(chunk) & ~(uintptr_t)(BLOCK_BYTES - 1));
+  }
+
+  // The block chunks are currently cut from
+  struct Block {
     char *bytes = nullptr;
     // the number of _bytes_ remaining in the block - when 0 we need a new block
     size_t remaining = 0;
@@ -91,48 +197,144 @@ class FixedSizeAllocator {
     void *alloc() {
       ASS_GE(remaining, SIZE);
       remaining -= SIZE;
-      return static_cast<void *>(bytes + remaining);
+      return static_cast<void *>(bytes + FIRST_CHUNK + remaining);
     }
   };
 
-  // the current block - old blocks are leaked
+  // the current block
   Block current;
-  /*
-   * The free list.
-   *
-   * This uses the block itself to store the free list.
-   * If `ptr` is freed, then free_list is updated to point to `ptr`,
-   * while `*ptr` points to the previous value of `free_list`.
-   */
-  void **free_list = nullptr;
+  // the blocks in each state but `FULL`, linked through their headers
+  Header *partial = nullptr;
+  Header *empty = nullptr;
+  Header *released = nullptr;
+  // the number of blocks that are not released
+  size_t blocksInUse = 0;
+  Arena arena;
+#if ALLOCATOR_TELEMETRY
+  AllocationCounts _counts;
+#endif
+
+  Header **listOf(typename Header::State state) {
+    switch(state) {
+    case Header::PARTIAL:
+      return &partial;
+    case Header::EMPTY:
+      return &empty;
+    case Header::RELEASED:
+      return &released;
+    default:
+      return nullptr;
+    }
+  }
+
+  // move `header` from the list of its state to the list of `state`
+  void setState(Header *header, typename Header::State state) {
+    if(Header **list = listOf(header->state)) {
+      if(header->prev)
+        header->prev->next = header->next;
+      else
+        *list = header->next;
+      if(header->next)
+        header->next->prev = header->prev;
+    }
+    header->state = state;
+    if(Header **list = listOf(state)) {
+      header->prev = nullptr;
+      header->next = *list;
+      if(*list)
+        (*list)->prev = header;
+      *list = header;
+    }
+  }
+
+  // start cutting chunks from a new block, reusing a released one if possible
+  void newBlock() {
+    Header *header = released;
+    if(!header) {
+      header = static_cast<Header *>(allocateAlignedBlock(BLOCK_BYTES, arena));
+      header->state = Header::FULL;
+    }
+    setState(header, Header::FULL);
+    header->live = 0;
+    header->free = nullptr;
+    blocksInUse++;
+
+    current.bytes = reinterpret_cast<char *>(header);
+    current.remaining = SIZE * ((BLOCK_BYTES - FIRST_CHUNK) / SIZE);
+  }
 
 public:
   // allocate a single chunk
   void *alloc() {
-    // first look if there's anything in the free list
-    if(free_list) {
-      void *recycled = free_list;
-      free_list = static_cast<void **>(*free_list);
-      return recycled;
+    void *chunk;
+    // first look for a freed chunk, preferring blocks with live chunks to keep empty ones reclaimable
+    Header *header = partial ? partial : empty;
+    if(header) {
+      chunk = header->free;
+      header->free = static_cast<void **>(*header->free);
+      if(!header->free)
+        setState(header, Header::FULL);
+      else if(header->state == Header::EMPTY)
+        setState(header, Header::PARTIAL);
     }
-
-    // then check if the current block has space
-    if(current.remaining)
-      return current.alloc();
-
-    // current block full, get a new one
-    current.bytes = static_cast<char *>(::operator new(COUNT * SIZE));
-    current.remaining = COUNT * SIZE;
-    return current.alloc();
+    else {
+      // then check if the current block has space, otherwise get a new one
+      if(!current.remaining)
+        newBlock();
+      chunk = current.alloc();
+      header = headerOf(chunk);
+    }
+    header->live++;
+#if ALLOCATOR_TELEMETRY
+    _counts.allocated(SIZE);
+#endif
+    return chunk;
   }
 
-  // move a chunk to the free list for reallocation
+  // move a chunk to the free list of its block for reallocation
   // NB `ptr` must have been allocated from this allocator
   void free(void *ptr) {
+    Header *header = headerOf(ptr);
+    ASS_G(header->live, 0)
+    header->live--;
+#if ALLOCATOR_TELEMETRY
+    _counts.freed(SIZE);
+#endif
+
     void **head = static_cast<void **>(ptr);
-    *head = free_list;
-    free_list = head;
+    *head = header->free;
+    header->free = head;
+    if(!header->live)
+      setState(header, Header::EMPTY);
+    else if(header->state == Header::FULL)
+      setState(header, Header::PARTIAL);
+  }
+
+  // release the pages of the blocks without live chunks, return how many bytes that was
+  size_t reclaim() {
+    size_t reclaimed = 0;
+    Header *header = empty;
+    while(header) {
+      Header *next = header->next;
+      // chunks may still be cut from the current block
+      if(reinterpret_cast<char *>(header) != current.bytes) {
+        // its free chunks go with it
+        setState(header, Header::RELEASED);
+        blocksInUse--;
+        releaseBlockPages(reinterpret_cast<char *>(header), BLOCK_BYTES);
+        reclaimed += BLOCK_BYTES;
+      }
+      header = next;
+    }
+    return reclaimed;
   }
+
+  // bytes of the blocks in use
+  size_t memory() const { return blocksInUse * BLOCK_BYTES; }
+
+#if ALLOCATOR_TELEMETRY
+  const AllocationCounts &counts() const { return _counts; }
+#endif
 };
 
 /*
@@ -183,6 +385,9 @@ public:
       return FSA8.alloc();
 
     // fall back to the system allocator for larger allocations
+#if ALLOCATOR_TELEMETRY
+    _larger.allocated(size);
+#endif
     return ::operator new(size, (std::align_val_t)align);
   }
 
@@ -207,9 +412,50 @@ public:
     if(size <= 8 * sizeof(void *))
       return FSA8.free(pointer);
 
+#if ALLOCATOR_TELEMETRY
+    _larger.freed(size);
+#endif
     ::operator delete(pointer, (std::align_val_t)align);
   }
 
+  // see `FixedSizeAllocator::reclaim()`
+  size_t reclaim() {
+    return FSA1.reclaim() + FSA2.reclaim() + FSA3.reclaim() + FSA4.reclaim() + FSA6.reclaim() + FSA8.reclaim();
+  }
+
+  // see `FixedSizeAllocator::memory()`, larger allocations are not included
+  size_t memory() const {
+    return FSA1.memory() + FSA2.memory() + FSA3.memory() + FSA4.memory() + FSA6.memory() + FSA8.memory();
+  }
+
+#if ALLOCATOR_TELEMETRY
+  // the fixed-size allocators and the fallback to the system allocator
+  static constexpr unsigned SIZE_CLASSES = 7;
+
+  // the chunk size of the `i`th size class, 0 for the fallback
+  static size_t sizeClassBytes(unsigned i) {
+    static const size_t BYTES[SIZE_CLASSES] = {
+      1 * sizeof(void *), 2 * sizeof(void *), 3 * sizeof(void *), 4 * sizeof(void *), 6 * sizeof(void *), 8 * sizeof(void *), 0
+    };
+    ASS_L(i, SIZE_CLASSES)
+    return BYTES[i];
+  }
+
+  const AllocationCounts &sizeClassCounts(unsigned i) const {
+    switch(i) {
+    case 0: return FSA1.counts();
+    case 1: return FSA2.counts();
+    case 2: return FSA3.counts();
+    case 3: return FSA4.counts();
+    case 4: return FSA6.counts();
+    case 5: return FSA8.counts();
+    default:
+      ASS_EQ(i, SIZE_CLASSES - 1)
+      return _larger;
+    }
+  }
+#endif
+
 private:
   // sizes tuned somewhat based on real allocation data, but I don't claim they couldn't be better!
   // when tuning, bear in mind that the larger the gap between sizes, the more memory is wasted
@@ -219,6 +465,9 @@ private:
   FixedSizeAllocator<4 * sizeof(void *)> FSA4;
   FixedSizeAllocator<6 * sizeof(void *)> FSA6;
   FixedSizeAllocator<8 * sizeof(void *)> FSA8;
+#if ALLOCATOR_TELEMETRY
+  AllocationCounts _larger;
+#endif
 };
 
 /*
@@ -275,19 +524,52 @@ inline void free(void *pointer, size_t size) {
 
 } // namespace Lib
 
+#if ALLOCATOR_TELEMETRY
+namespace Lib {
+// allocate like `alloc(size)`, counting the allocation in `counts`
+[[gnu::alloc_size(1)]]
+[[gnu::returns_nonnull]]
+[[nodiscard]]
+inline void *alloc(size_t size, AllocationCounts &counts) {
+  counts.allocated(size);
+  return alloc(size);
+}
+
+// deallocate like `free(pointer, size)`, counting the deallocation in `counts`
+inline void free(void *pointer, size_t size, AllocationCounts &counts) {
+  if(pointer)
+    counts.freed(size);
+  free(pointer, size);
+}
+} // namespace Lib
+
+// overload class-specific operator new to call the global small-object allocator, counting the allocations of C
+#define USE_GLOBAL_SMALL_OBJECT_ALLOCATOR(C) \
+  void *operator new(size_t size) { ALLOCATION_COUNTS(#C).allocated(size); return Lib::alloc(size, alignof(C)); }\
+  void *operator new(size_t size, std::align_val_t align) { ALLOCATION_COUNTS(#C).allocated(size); return Lib::alloc(size, (size_t)align); }\
+  void operator delete(void *ptr, size_t size) { ALLOCATION_COUNTS(#C).freed(size); Lib::free(ptr, size, alignof(C)); } \
+  void operator delete(void *ptr, size_t size, std::align_val_t align) { ALLOCATION_COUNTS(#C).freed(size); Lib::free(ptr, size, (size_t)align); }
+#else
 // overload class-specific operator new to call the global small-object allocator
 #define USE_GLOBAL_SMALL_OBJECT_ALLOCATOR(C) \
   void *operator new(size_t size) { return Lib::alloc(size, alignof(C)); }\
   void *operator new(size_t size, std::align_val_t align) { return Lib::alloc(size, (size_t)align); }\
   void operator delete(void *ptr, size_t size) { Lib::free(ptr, size, alignof(C)); } \
   void operator delete(void *ptr, size_t size, std::align_val_t align) { Lib::free(ptr, size, (size_t)align); }
+#endif // ALLOCATOR_TELEMETRY
 
 #endif // INDIVIDUAL_ALLOCATIONS's else
 
 // legacy macros, should be removed eventually
 #define USE_ALLOCATOR(C) USE_GLOBAL_SMALL_OBJECT_ALLOCATOR(C)
+#if ALLOCATOR_TELEMETRY && !defined(INDIVIDUAL_ALLOCATIONS)
+// `className` must be a string literal
+#define ALLOC_KNOWN(size, className) Lib::alloc(size, ALLOCATION_COUNTS(className))
+#define DEALLOC_KNOWN(ptr, size, className) Lib::free(ptr, size, ALLOCATION_COUNTS(className))
+#else
 #define ALLOC_KNOWN(size, className) Lib::alloc(size)
 #define DEALLOC_KNOWN(ptr, size, className) Lib::free(ptr, size)
+#endif
 
 // TODO dubious: probably a compiler lint these days?
 /**
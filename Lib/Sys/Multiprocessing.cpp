@@ -14,9 +14,15 @@
 
 #include <cerrno>
 #include <csignal>
+#include <fstream>
+#include <limits>
+#include <string>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
 
 #include "Debug/TimeProfiling.hpp"
 #include "Lib/Exception.hpp"
@@ -44,6 +50,19 @@ pid_t Multiprocessing::fork()
   return res;
 }
 
+/**
+ * Make orphaned descendants of this process become its children (rather than children of init),
+ * so that they can be waited for. Return false if not supported on this platform.
+ */
+bool Multiprocessing::becomeSubreaper()
+{
+#ifdef __linux__
+  return prctl(PR_SET_CHILD_SUBREAPER, 1) == 0;
+#else
+  return false;
+#endif
+}
+
 /**
  * Wait for a first child process to terminate, return its pid and assign
  * its exit status into @b resValue. If the child was terminated by a signal,
@@ -88,17 +107,89 @@ void Multiprocessing::killNoCheck(pid_t child, int signal)
   ::kill(child, signal);
 }
 
-pid_t Multiprocessing::poll_children(bool &exited, bool &signalled, int &code)
+/**
+ * Kill a child (which may be stopped) and wait for it to terminate,
+ * so that its termination is not reported by a later call to poll_children.
+ *
+ * Return false if the child exited successfully (with code 0) before it could be killed.
+ */
+bool Multiprocessing::killAndReap(pid_t child)
 {
   int status;
-  pid_t pid = waitpid(-1 /*wait for any child*/, &status, WUNTRACED);
+  errno=0;
+  // the child may be gone already, its result must not get lost then
+  pid_t res = waitpid(child, &status, WNOHANG);
+  if(res == -1) {
+    SYSTEM_FAIL("Call to waitpid() function failed.", errno);
+  }
+  if(res == 0) {
+    kill(child, SIGKILL);
+    if(waitpid(child, &status, 0) == -1) {
+      SYSTEM_FAIL("Call to waitpid() function failed.", errno);
+    }
+  }
+  // it could also have exited just before being killed
+  return !WIFEXITED(status) || WEXITSTATUS(status);
+}
+
+/**
+ * Return the resident set size of a child in bytes, or 0 if it cannot be determined.
+ */
+size_t Multiprocessing::residentMemory(pid_t child)
+{
+  std::ifstream statm("/proc/" + std::to_string(child) + "/statm");
+  size_t size, resident;
+  if(!(statm >> size >> resident)) {
+    return 0;
+  }
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Return the proportional set size of a child in bytes, or 0 if it cannot be determined:
+ * the pages it shares (e.g. copy-on-write with the process it was forked from) are divided
+ * between the processes sharing them, so that the sizes of several processes add up.
+ */
+size_t Multiprocessing::proportionalMemory(pid_t child)
+{
+  std::ifstream rollup("/proc/" + std::to_string(child) + "/smaps_rollup");
+  std::string field;
+  size_t kilobytes;
+  while(rollup >> field) {
+    if(field == "Pss:") {
+      return (rollup >> kilobytes) ? kilobytes * 1024 : 0;
+    }
+    rollup.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+
+  // before Linux 4.14: leave the shared pages out altogether
+  std::ifstream statm("/proc/" + std::to_string(child) + "/statm");
+  size_t size, resident, shared;
+  if(!(statm >> size >> resident >> shared)) {
+    return 0;
+  }
+  return (resident - shared) * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Wait for a child to exit, be killed or stopped and return its pid.
+ * If @b block is false, return 0 straight away if no child changed its state.
+ */
+pid_t Multiprocessing::poll_children(bool &exited, bool &signalled, bool &stopped, int &code, bool block)
+{
+  int status;
+  pid_t pid = waitpid(-1 /*wait for any child*/, &status, block ? WUNTRACED : WUNTRACED | WNOHANG);
 
   if (pid == -1) {
     SYSTEM_FAIL("Call to waitpid() function failed.", errno);
   }
+  if (pid == 0) {
+    return 0;
+  }
 
   exited = WIFEXITED(status);
   signalled = WIFSIGNALED(status);
+  stopped = WIFSTOPPED(status);
   if(exited)
   {
     code = WEXITSTATUS(status);
@@ -107,6 +198,10 @@ pid_t Multiprocessing::poll_children(bool &exited, bool &signalled, int &code)
   {
     code = WTERMSIG(status);
   }
+  if(stopped)
+  {
+    code = WSTOPSIG(status);
+  }
   return pid;
 }
 
@@ -26,10 +26,14 @@ public:
 
   pid_t waitForChildTermination(int& resValue);
   pid_t fork();
+  bool becomeSubreaper();
 
   void kill(pid_t child, int signal);
   void killNoCheck(pid_t child, int signal);
-  pid_t poll_children(bool &exited, bool &signalled, int &code);
+  pid_t poll_children(bool &exited, bool &signalled, bool &stopped, int &code, bool block = true);
+  bool killAndReap(pid_t child);
+  size_t residentMemory(pid_t child);
+  size_t proportionalMemory(pid_t child);
 };
 
 }
@@ -71,6 +71,17 @@ const char* signalToString (int sigNum)
 // avoids catching signals over and over again
 static std::sig_atomic_t TERMINAL_SIGNAL_HANDLED = false;
 
+// set by SIGUSR1, the report is printed outside the handler
+static volatile std::sig_atomic_t ALLOCATION_REPORT_REQUESTED = false;
+
+bool System::allocationReportRequested()
+{
+  if(!ALLOCATION_REPORT_REQUESTED)
+    return false;
+  ALLOCATION_REPORT_REQUESTED = false;
+  return true;
+}
+
 /**
  * Signal handling function. Rewritten from the kernel standalone.
  *
@@ -84,6 +95,13 @@ void handleSignal (int sigNum)
     return;
 
   switch(sigNum) {
+#if ALLOCATOR_TELEMETRY && !defined(_MSC_VER)
+  // dump the allocation telemetry at the next opportunity, then carry on
+  case SIGUSR1:
+    ALLOCATION_REPORT_REQUESTED = true;
+    return;
+#endif
+
   // polite non-crashing interrupts, shut up and exit immediately
   case SIGINT:
   case SIGTERM:
@@ -140,6 +158,9 @@ void System::setSignalHandlers()
   signal(SIGXCPU,handleSignal);
   signal(SIGBUS,handleSignal);
   signal(SIGTRAP,handleSignal);
+#if ALLOCATOR_TELEMETRY
+  signal(SIGUSR1,handleSignal);
+#endif
 #endif
 }
 
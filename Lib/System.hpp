@@ -38,6 +38,9 @@ public:
   }
 
   static void registerForSIGHUPOnParentDeath();
+
+  // true (once) if SIGUSR1 asked for the allocation telemetry since the last call
+  static bool allocationReportRequested();
 };
 
 }
@@ -0,0 +1,321 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file TaggedSet.hpp
+ * Defines class TaggedSet<Val> of sets of pointers, keeping some bits of their hash codes in the pointers.
+ */
+
+#ifndef __TaggedSet__
+#define __TaggedSet__
+
+#include <cstdint>
+#include <type_traits>
+
+#include "Forwards.hpp"
+
+#include "Allocator.hpp"
+#include "Hash.hpp"
+#include "Reflection.hpp"
+#include "Lib/Metaiterators.hpp"
+
+namespace Lib {
+
+/**
+ * An open-addressing hash set of pointers with the interface of Set,
+ * for large sets probed far more often than they change, such as the sharing of terms.
+ * Values are compared using Hash::equals.
+ *
+ * User-space addresses fit into 48 bits, so every cell keeps 16 bits of the hash code
+ * of its value (the tag) in the unused top bits of the pointer, as Swiss tables keep tags
+ * in their control bytes. Lookups only dereference values with the right tag,
+ * which is almost never a different value. Cells are 8 bytes, half of those of Set,
+ * so that linear probing sees 8 of them per cache line.
+ *
+ * The full hash codes are kept in a separate array, only read when growing,
+ * so that values need not be dereferenced to be rehashed.
+ */
+template <typename Val, class Hash>
+class TaggedSet
+{
+  static_assert(std::is_pointer<Val>::value && sizeof(Val) == sizeof(uint64_t), "values must be 64-bit pointers");
+
+  typedef uint64_t Cell;
+  static constexpr Cell EMPTY = 0;
+  static constexpr Cell DELETED = 1;
+  static constexpr Cell ADDRESS = (Cell(1) << 48) - 1;
+
+  // spread the bits of a hash code: the tag is taken from the top, the first cell from the middle
+  static uint64_t mix(unsigned code)
+  { return uint64_t(code) * 0x9E3779B97F4A7C15ull; }
+  static Cell tagOf(uint64_t mixed)
+  { return mixed & ~ADDRESS; }
+  size_t firstCell(uint64_t mixed) const
+  { return (mixed >> 20) & (_capacity - 1); }
+  size_t nextCell(size_t cell) const
+  { return (cell + 1) & (_capacity - 1); }
+
+  static Cell cellOf(Val val, Cell tag)
+  {
+    Cell address = reinterpret_cast<uintptr_t>(val);
+    ASS_EQ(address & ~ADDRESS, 0)
+    ASS_G(address, DELETED)
+    return address | tag;
+  }
+  static Val valueOf(Cell cell)
+  { return reinterpret_cast<Val>(cell & ADDRESS); }
+
+public:
+  // use allocator to (de)allocate objects of this class
+  USE_ALLOCATOR(TaggedSet);
+
+  /** Create a new TaggedSet */
+  TaggedSet()
+    : _capacity(0),
+      _size(0),
+      _used(0),
+      _maxUsed(0),
+      _cells(nullptr),
+      _codes(nullptr)
+  {
+    rehash(INITIAL_CAPACITY);
+  } // TaggedSet::TaggedSet
+
+  TaggedSet(const TaggedSet&) = delete;
+  TaggedSet& operator=(const TaggedSet&) = delete;
+
+  /** Deallocate the set */
+  ~TaggedSet()
+  {
+    DEALLOC_KNOWN(_cells, bytesFor(_capacity), "TaggedSet::Cell");
+  } // TaggedSet::~TaggedSet
+
+  /**
+   * If the set contains value equal to @b key, return true,
+   * and assign the value to @b result
+   *
+   * Hash class has to contain methods
+   * Hash::hash(Key)
+   * Hash::equals(Val,Key)
+   */
+  template<typename Key>
+  bool find(Key key, Val& result) const
+  {
+    size_t index;
+    if (!findIndex(Hash::hash(key), [&](Val val) { return Hash::equals(val, key); }, index)) {
+      return false;
+    }
+    result = valueOf(_cells[index]);
+    return true;
+  } // TaggedSet::find
+
+  /** True if the set contains @b val */
+  bool contains(Val val) const
+  {
+    size_t index;
+    return findIndex(Hash::hash(val), [&](Val other) { return Hash::equals(other, val); }, index);
+  } // TaggedSet::contains
+
+  /**
+   * Return the value with hash code @b hashCode satisfying @b isCorrectVal,
+   * and if there is none, insert the value returned by @b create, setting @b inserted.
+   * See Set::rawFindOrInsert, but values are returned by value, as they are stored tagged.
+   */
+  template<class Create, class IsCorrectVal>
+  Val rawFindOrInsert(Create create, unsigned hashCode, IsCorrectVal isCorrectVal, bool& inserted)
+  {
+    inserted = false;
+    if (_used >= _maxUsed) {
+      grow();
+    }
+
+    uint64_t mixed = mix(hashCode);
+    Cell tag = tagOf(mixed);
+    // the first deleted cell on the way, to be reused
+    size_t free = SIZE_MAX;
+    size_t index = firstCell(mixed);
+    for (;; index = nextCell(index)) {
+      Cell cell = _cells[index];
+      if (cell == EMPTY) {
+        break;
+      }
+      if (cell == DELETED) {
+        if (free == SIZE_MAX) {
+          free = index;
+        }
+      } else if ((cell & ~ADDRESS) == tag && isCorrectVal(valueOf(cell))) {
+        return valueOf(cell);
+      }
+    }
+
+    if (free == SIZE_MAX) {
+      free = index;
+      _used++;
+    }
+    _size++;
+    _cells[free] = cellOf(create(), tag);
+    _codes[free] = hashCode;
+    inserted = true;
+    ASS_EQ(Hash::hash(valueOf(_cells[free])), hashCode)
+    return valueOf(_cells[free]);
+  } // TaggedSet::rawFindOrInsert
+
+  template<class Create, class IsCorrectVal>
+  Val rawFindOrInsert(Create create, unsigned hashCode, IsCorrectVal isCorrectVal)
+  { bool b; return rawFindOrInsert(std::move(create), hashCode, std::move(isCorrectVal), b); }
+
+  /**
+   * If a value equal to @b val is not contained in the set, insert @b val
+   * in the set.
+   * Return the value equal to @b val from the set.
+   */
+  Val insert(Val val)
+  { return rawFindOrInsert([&]() { return val; }, Hash::hash(val), [&](Val other) { return Hash::equals(other, val); }); }
+
+  /**
+   * Remove a value from the set. Return true if the value is found
+   */
+  bool remove(Val val)
+  {
+    size_t index;
+    if (!findIndex(Hash::hash(val), [&](Val other) { return Hash::equals(other, val); }, index)) {
+      return false;
+    }
+    _cells[index] = DELETED;
+    _size--;
+    return true;
+  } // TaggedSet::remove
+
+  /** Return the number of (non-deleted) elements */
+  unsigned size() const
+  { return _size; }
+
+private:
+  static constexpr size_t INITIAL_CAPACITY = 32;
+
+  // bytes of `capacity` cells and their hash codes, in one allocation
+  static size_t bytesFor(size_t capacity)
+  { return capacity * (sizeof(Cell) + sizeof(unsigned)); }
+
+  // find the index of the value with `hashCode` satisfying `isCorrectVal`
+  template<class IsCorrectVal>
+  bool findIndex(unsigned hashCode, IsCorrectVal isCorrectVal, size_t& index) const
+  {
+    uint64_t mixed = mix(hashCode);
+    Cell tag = tagOf(mixed);
+    for (index = firstCell(mixed);; index = nextCell(index)) {
+      Cell cell = _cells[index];
+      if (cell == EMPTY) {
+        return false;
+      }
+      if (cell != DELETED && (cell & ~ADDRESS) == tag && isCorrectVal(valueOf(cell))) {
+        return true;
+      }
+    }
+  } // TaggedSet::findIndex
+
+  /**
+   * Make room for more values: double the capacity, unless the set is mostly
+   * full of deleted cells, which are then simply cleared.
+   */
+  void grow()
+  {
+    rehash(_size * 2 > _maxUsed ? _capacity * 2 : _capacity);
+  } // TaggedSet::grow
+
+  // move the values to a fresh table of `capacity` cells, a power of two
+  void rehash(size_t capacity)
+  {
+    ASS_EQ(capacity & (capacity - 1), 0)
+    Cell* oldCells = _cells;
+    unsigned* oldCodes = _codes;
+    size_t oldCapacity = _capacity;
+
+    _cells = static_cast<Cell*>(ALLOC_KNOWN(bytesFor(capacity), "TaggedSet::Cell"));
+    _codes = reinterpret_cast<unsigned*>(_cells + capacity);
+    _capacity = capacity;
+    _used = _size;
+    // same load factor as Set
+    _maxUsed = capacity / 5 * 4;
+    for (size_t i = 0; i < capacity; i++) {
+      _cells[i] = EMPTY;
+    }
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+      if (oldCells[i] == EMPTY || oldCells[i] == DELETED) {
+        continue;
+      }
+      size_t index = firstCell(mix(oldCodes[i]));
+      while (_cells[index] != EMPTY) {
+        index = nextCell(index);
+      }
+      _cells[index] = oldCells[i];
+      _codes[index] = oldCodes[i];
+    }
+
+    if (oldCells) {
+      DEALLOC_KNOWN(oldCells, bytesFor(oldCapacity), "TaggedSet::Cell");
+    }
+  } // TaggedSet::rehash
+
+  /** the number of cells, a power of two */
+  size_t _capacity;
+  /** the number of values */
+  size_t _size;
+  /** the number of cells that are not empty (values and deleted ones) */
+  size_t _used;
+  /** the set grows when this many cells are used */
+  size_t _maxUsed;
+  /** the cells, each empty, deleted, or a value with its tag */
+  Cell* _cells;
+  /** the hash codes of the values in the cells, following them in the same allocation */
+  unsigned* _codes;
+
+public:
+  /**
+   * Class to allow iteration over values stored in the set.
+   */
+  class Iterator {
+  public:
+    DECL_ELEMENT_TYPE(Val);
+
+    explicit Iterator(const TaggedSet& set)
+      : _next(set._cells), _last(set._cells + set._capacity)
+    {}
+
+    bool hasNext()
+    {
+      while (_next != _last && (*_next == EMPTY || *_next == DELETED)) {
+        _next++;
+      }
+      return _next != _last;
+    } // TaggedSet::Iterator::hasNext
+
+    /** @warning hasNext() must have been called before */
+    Val next()
+    {
+      ASS(_next != _last);
+      return valueOf(*_next++);
+    } // TaggedSet::Iterator::next
+
+  private:
+    /** iterator will look for the next value starting with this cell */
+    Cell* _next;
+    /** iterator will stop looking for the next value after reaching this cell */
+    Cell* _last;
+  };
+  DECL_ITERATOR_TYPE(Iterator);
+
+  IterTraits<Iterator> iter() const
+  { return iterTraits(Iterator(*this)); }
+}; // class TaggedSet
+
+} // namespace Lib
+
+#endif // __TaggedSet__
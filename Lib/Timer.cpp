@@ -12,11 +12,16 @@
  * Implements class Timer.
  */
 
+#include <atomic>
 #include <iostream>
 #include <mutex>
 #include <thread>
+#include <climits>
+#include <csignal>
+#include <unistd.h>
 
 #include "Lib/Environment.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "System.hpp"
@@ -105,20 +110,81 @@ static std::mutex EXIT_LOCK;
 
 static std::chrono::time_point<std::chrono::steady_clock> START_TIME;
 
+// if positive, suspend rather than exit on resource out, see Timer::suspendOnLimit
+static float SUSPEND_LIMIT_MULTIPLIER = 0;
+
+// called by timer_thread to stop the entire process until the parent resumes it
+static void suspend()
+{
+  // if we can't get this lock the main thread is about to report success, let it
+  EXIT_LOCK.lock();
+
+  auto stopped = std::chrono::steady_clock::now();
+  kill(getpid(), SIGSTOP);
+  // ...we get here only after SIGCONT: pretend we were never stopped
+  START_TIME += std::chrono::steady_clock::now() - stopped;
+
+  EXIT_LOCK.unlock();
+}
+
+// if non-negative, the pipe to report progress to, see Timer::sendHeartbeats
+static int HEARTBEAT_FD = -1;
+const long HEARTBEAT_INTERVAL_MS = 200;
+
+// the progress counters of env.statistics as last published by the main thread, see Timer::publishProgress
+static std::atomic<unsigned> ACTIVATIONS(0);
+static std::atomic<unsigned> RETAINED(0);
+static std::atomic<unsigned> GENERATED(0);
+
+// called by timer_thread: the counters may be slightly stale, which does not matter here
+static void sendHeartbeat()
+{
+  Lib::Timer::Heartbeat heartbeat;
+  heartbeat.pid = getpid();
+  heartbeat.activations = ACTIVATIONS.load(std::memory_order_relaxed);
+  heartbeat.retained = RETAINED.load(std::memory_order_relaxed);
+  heartbeat.generated = GENERATED.load(std::memory_order_relaxed);
+  heartbeat.memory = Lib::Sys::Multiprocessing::instance()->residentMemory(heartbeat.pid);
+
+  // atomic as it is smaller than PIPE_BUF, dropped if the parent does not keep up
+  static_assert(sizeof(heartbeat) <= PIPE_BUF, "heartbeats must be written atomically");
+  ssize_t res = write(HEARTBEAT_FD, &heartbeat, sizeof(heartbeat));
+  (void)res;
+}
+
 // TODO could maybe be more efficient if we special-case the no-instruction-limit case:
 // then, we could simply sleep until the time limit
 [[noreturn]] void timer_thread()
 {
   unsigned limit = env.options->timeLimitInDeciseconds();
+#if VAMPIRE_PERF_EXISTS
+  unsigned instructionLimit = env.options->instructionLimit();
+#endif
+  long nextHeartbeat = 0;
   while(true) {
+    if(HEARTBEAT_FD >= 0 && Timer::elapsedMilliseconds() >= nextHeartbeat) {
+      sendHeartbeat();
+      nextHeartbeat = Timer::elapsedMilliseconds() + HEARTBEAT_INTERVAL_MS;
+    }
+
     if(limit && Timer::elapsedDeciseconds() >= limit) {
+      if(SUSPEND_LIMIT_MULTIPLIER > 0) {
+        suspend();
+        limit *= SUSPEND_LIMIT_MULTIPLIER;
+        continue;
+      }
       limitReached(TIME_LIMIT);
     }
 
 #if VAMPIRE_PERF_EXISTS
-    if(env.options->instructionLimit() || env.options->simulatedInstructionLimit()) {
+    if(instructionLimit || env.options->simulatedInstructionLimit()) {
       Timer::updateInstructionCount();
-      if (env.options->instructionLimit() && LAST_INSTRUCTION_COUNT_READ >= MEGA*(long long)env.options->instructionLimit()) {
+      if (instructionLimit && LAST_INSTRUCTION_COUNT_READ >= MEGA*(long long)instructionLimit) {
+        if(SUSPEND_LIMIT_MULTIPLIER > 0) {
+          suspend();
+          instructionLimit *= SUSPEND_LIMIT_MULTIPLIER;
+          continue;
+        }
         // in principle could have a race on terminationReason, seems unlikely/harmless in practice
         env.statistics->terminationReason = Shell::Statistics::TIME_LIMIT;
         limitReached(INSTRUCTION_LIMIT);
@@ -182,6 +248,24 @@ void reinitialise() {
   std::thread(timer_thread).detach();
 }
 
+void suspendOnLimit(float limitMultiplier) {
+  ASS_G(limitMultiplier, 1)
+  SUSPEND_LIMIT_MULTIPLIER = limitMultiplier;
+}
+
+void sendHeartbeats(int fd) {
+  HEARTBEAT_FD = fd;
+}
+
+void publishProgress() {
+  if(HEARTBEAT_FD < 0) {
+    return;
+  }
+  ACTIVATIONS.store(env.statistics->activeClauses, std::memory_order_relaxed);
+  RETAINED.store(env.statistics->passiveClauses, std::memory_order_relaxed);
+  GENERATED.store(env.statistics->generatedClauses, std::memory_order_relaxed);
+}
+
 void disableLimitEnforcement() {
   EXIT_LOCK.lock();
 }
@@ -16,8 +16,10 @@
 #ifndef __Timer__
 #define __Timer__
 
+#include <cstddef>
 #include <ostream>
 #include <string>
+#include <sys/types.h>
 
 namespace Lib {
 namespace Timer {
@@ -28,6 +30,35 @@ namespace Timer {
   // should be called exactly once per process as it internally spawns a std::thread
   void reinitialise();
 
+  // instead of exiting when a resource limit is reached, stop the process (SIGSTOP)
+  // and wait to be resumed (SIGCONT) by the parent, after which the limits
+  // are multiplied by `limitMultiplier` and time spent stopped does not count
+  //
+  // must be called before `reinitialise()`
+  void suspendOnLimit(float limitMultiplier);
+
+  // progress of a portfolio slice, as reported to the parent
+  struct Heartbeat {
+    pid_t pid;
+    // clauses activated and clauses retained (i.e. added to passive) so far
+    unsigned activations;
+    unsigned retained;
+    unsigned generated;
+    // resident memory in bytes
+    size_t memory;
+  };
+
+  // periodically write a `Heartbeat` to the (non-blocking) pipe `fd`
+  //
+  // must be called before `reinitialise()`
+  void sendHeartbeats(int fd);
+
+  // copy the progress counters of `env.statistics` for the heartbeats,
+  // which may not read them while the main thread updates them
+  //
+  // called by the main thread, also in the middle of long steps
+  void publishProgress();
+
   // disables exit on resource out: call when a proof has been found!
   // permanently disabled per-process
   // blocks if a resource limit was already reached and we are exiting
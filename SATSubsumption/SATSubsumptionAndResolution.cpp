@@ -333,6 +333,11 @@ bool SATSubsumptionAndResolution::checkAndAddMatch(Literal* l_i,
   ASS_EQ(l_i->functor(), m_j->functor())
   ASS_EQ(l_i->polarity() == m_j->polarity(), polarity)
 
+  // cheap rejection, before setting up any bindings
+  if (!l_i->mayGeneralize(m_j)) {
+    return false;
+  }
+
   bool match = false;
   {
     auto binder = _bindingsManager.start_binder();
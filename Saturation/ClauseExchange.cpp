@@ -0,0 +1,266 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file ClauseExchange.cpp
+ * Implements class ClauseExchange.
+ */
+
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Hash.hpp"
+
+#include "Kernel/Inference.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "ClauseExchange.hpp"
+
+namespace Saturation {
+
+// marks variables among functors, and positive literals among predicates
+static const uint32_t VAR_TAG = 1u << 31;
+static const uint32_t POSITIVE_TAG = 1u << 31;
+
+ClauseExchange* ClauseExchange::s_instance = nullptr;
+
+ClauseExchange::ClauseExchange(Buffer* buffer)
+  : _buffer(buffer),
+    _functions(env.signature->functions()),
+    _predicates(env.signature->predicates()),
+    _typeCons(env.signature->typeCons()),
+    _next(0)
+{}
+
+void ClauseExchange::create()
+{
+  if (s_instance) {
+    // shared by all the schedules of this run
+    return;
+  }
+
+  errno = 0;
+  void* memory = mmap(nullptr, sizeof(Buffer), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    SYSTEM_FAIL("Call to mmap() function failed.", errno);
+  }
+  // anonymous mappings are zero-filled, which is a valid empty buffer
+  s_instance = new ClauseExchange(static_cast<Buffer*>(memory));
+}
+
+/**
+ * Return the exchange if the slice given by @b prb and @b opt can use it, nullptr otherwise.
+ *
+ * Slices randomly flipping predicate polarities give the shared symbols a different meaning,
+ * and arithmetic subterm generalization derives clauses that are not consequences of the input.
+ */
+ClauseExchange* ClauseExchange::tryGetInstance(const Problem& prb, const Options& opt)
+{
+  if (!s_instance || prb.isHigherOrder() || prb.hasPolymorphicSym() || opt.randomPolarities() ||
+      opt.arithmeticSubtermGeneralizations() != Options::ArithmeticSimplificationMode::OFF) {
+    return nullptr;
+  }
+  return s_instance;
+}
+
+uint32_t ClauseExchange::checksum(uint64_t position, const uint32_t* words, unsigned length)
+{
+  return DefaultHash::hashBytes(reinterpret_cast<const unsigned char*>(words), length * sizeof(uint32_t),
+    DefaultHash::hash(position));
+}
+
+bool ClauseExchange::encodeTerm(TermList t, bool sort)
+{
+  if (_words.size() >= SLOT_WORDS) {
+    return false;
+  }
+  if (t.isOrdinaryVar()) {
+    if (t.var() & VAR_TAG) {
+      return false;
+    }
+    _words.push(VAR_TAG | t.var());
+    return true;
+  }
+  if (!t.isTerm() || t.term()->isSpecial()) {
+    return false;
+  }
+  Term* trm = t.term();
+  if (trm->functor() >= (sort ? _typeCons : _functions)) {
+    return false;
+  }
+  _words.push(trm->functor());
+  for (unsigned i = 0; i < trm->arity(); i++) {
+    if (!encodeTerm(*trm->nthArgument(i), sort)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Encode @b cl into _words, return false if it does not qualify for exchange.
+ *
+ * Every literal is encoded as its predicate (tagged with the polarity)
+ * followed by its arguments in prefix order, equalities also store their sort first.
+ */
+bool ClauseExchange::encode(Clause* cl)
+{
+  _words.reset();
+  for (Literal* l : cl->iterLits()) {
+    if (l->functor() >= _predicates) {
+      return false;
+    }
+    _words.push((l->polarity() ? POSITIVE_TAG : 0) | l->functor());
+    if (l->isEquality() && !encodeTerm(SortHelper::getEqualityArgumentSort(l), true)) {
+      return false;
+    }
+    for (unsigned i = 0; i < l->arity(); i++) {
+      if (!encodeTerm(*l->nthArgument(i), false)) {
+        return false;
+      }
+    }
+  }
+  return _words.size() <= SLOT_WORDS;
+}
+
+bool ClauseExchange::publish(Clause* cl)
+{
+  if (cl->weight() > env.options->portfolioClauseExchangeWeight() || !cl->noSplits() ||
+      cl->color() != COLOR_TRANSPARENT || cl->inference().rule() == InferenceRule::PORTFOLIO_IMPORT ||
+      !encode(cl)) {
+    return false;
+  }
+
+  uint64_t position = _buffer->head.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = _buffer->slots[position % SLOTS];
+
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  unsigned length = _words.size();
+  for (unsigned i = 0; i < length; i++) {
+    slot.words[i].store(_words[i], std::memory_order_relaxed);
+  }
+  slot.length.store(length, std::memory_order_relaxed);
+  slot.publisher.store(getpid(), std::memory_order_relaxed);
+  slot.checksum.store(checksum(position, _words.begin(), length), std::memory_order_relaxed);
+
+  slot.sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+void ClauseExchange::import(Stack<Clause*>& clauses)
+{
+  uint64_t head = _buffer->head.load(std::memory_order_acquire);
+  if (head - _next > SLOTS) {
+    // the oldest ones have been overwritten already
+    _next = head - SLOTS;
+  }
+
+  uint32_t self = getpid();
+  for (; _next < head; _next++) {
+    Slot& slot = _buffer->slots[_next % SLOTS];
+    // skip slots still being written, or already reused
+    if (slot.sequence.load(std::memory_order_acquire) != _next + 1) {
+      continue;
+    }
+    unsigned length = slot.length.load(std::memory_order_relaxed);
+    uint32_t publisher = slot.publisher.load(std::memory_order_relaxed);
+    uint32_t sum = slot.checksum.load(std::memory_order_relaxed);
+    if (length > SLOT_WORDS) {
+      continue;
+    }
+    _words.reset();
+    for (unsigned i = 0; i < length; i++) {
+      _words.push(slot.words[i].load(std::memory_order_relaxed));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != _next + 1 ||
+        publisher == self || sum != checksum(_next, _words.begin(), length)) {
+      continue;
+    }
+
+    if (Clause* cl = decode(_words.begin(), length)) {
+      clauses.push(cl);
+    }
+  }
+}
+
+bool ClauseExchange::decodeTerm(const uint32_t*& words, const uint32_t* end, bool sort, TermList& res)
+{
+  if (words == end) {
+    return false;
+  }
+  uint32_t word = *words++;
+  if (word & VAR_TAG) {
+    res = TermList::var(word & ~VAR_TAG);
+    return true;
+  }
+  if (word >= (sort ? _typeCons : _functions)) {
+    return false;
+  }
+  unsigned arity = sort ? env.signature->getTypeCon(word)->arity() : env.signature->getFunction(word)->arity();
+  if (arity > SLOT_WORDS) {
+    return false;
+  }
+  TermList args[SLOT_WORDS];
+  for (unsigned i = 0; i < arity; i++) {
+    if (!decodeTerm(words, end, sort, args[i])) {
+      return false;
+    }
+  }
+  res = sort ? TermList(AtomicSort::create(word, arity, args)) : TermList(Term::create(word, arity, args));
+  return true;
+}
+
+Clause* ClauseExchange::decode(const uint32_t* words, unsigned length)
+{
+  const uint32_t* end = words + length;
+  Stack<Literal*> lits;
+  while (words != end) {
+    uint32_t header = *words++;
+    bool polarity = header & POSITIVE_TAG;
+    unsigned pred = header & ~POSITIVE_TAG;
+    if (pred >= _predicates) {
+      return nullptr;
+    }
+
+    if (pred == 0) {
+      TermList sort, lhs, rhs;
+      if (!decodeTerm(words, end, true, sort) || !decodeTerm(words, end, false, lhs) || !decodeTerm(words, end, false, rhs)) {
+        return nullptr;
+      }
+      lits.push(Literal::createEquality(polarity, lhs, rhs, sort));
+      continue;
+    }
+
+    unsigned arity = env.signature->getPredicate(pred)->arity();
+    if (arity > SLOT_WORDS) {
+      return nullptr;
+    }
+    TermList args[SLOT_WORDS];
+    for (unsigned i = 0; i < arity; i++) {
+      if (!decodeTerm(words, end, false, args[i])) {
+        return nullptr;
+      }
+    }
+    lits.push(Literal::create(pred, arity, polarity, args));
+  }
+  return Clause::fromStack(lits, NonspecificInference0(UnitInputType::AXIOM, InferenceRule::PORTFOLIO_IMPORT));
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file ClauseExchange.hpp
+ * Defines class ClauseExchange for sharing clauses between portfolio slices.
+ */
+
+#ifndef __ClauseExchange__
+#define __ClauseExchange__
+
+#include <atomic>
+#include <cstdint>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+
+/**
+ * A ring buffer in memory shared by all the slices of a portfolio run,
+ * through which the slices publish cheap clauses for the others to import.
+ *
+ * The buffer is created by the portfolio parent before the slices are forked.
+ * Since all slices inherit the parent's signature, a clause built only from
+ * symbols that existed at that point means the same in every slice,
+ * so it is stored by symbol numbers. Clauses mentioning symbols introduced
+ * later (names, skolems, splitting predicates, ...) are never published.
+ *
+ * Publishing and importing are lock-free: a slot is claimed by incrementing
+ * the shared head and readers detect slots being (over)written by a sequence
+ * number and a checksum, skipping them.
+ */
+class ClauseExchange {
+public:
+  USE_ALLOCATOR(ClauseExchange);
+
+  // called by the portfolio parent before forking the slices, does nothing if already created
+  static void create();
+  static ClauseExchange* tryGetInstance(const Problem& prb, const Options& opt);
+
+  // publish @b cl for the other slices if it qualifies, return whether it did
+  bool publish(Clause* cl);
+  // collect into @b clauses the clauses published by other slices since the last call
+  void import(Stack<Clause*>& clauses);
+
+private:
+  // the clause (in 32-bit words) must fit into a single slot
+  static const unsigned SLOT_WORDS = 60;
+  static const unsigned SLOTS = 4096;
+
+  struct Slot {
+    // position of the stored clause plus one, 0 while being written
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint32_t> publisher;
+    std::atomic<uint32_t> length;
+    std::atomic<uint32_t> checksum;
+    std::atomic<uint32_t> words[SLOT_WORDS];
+  };
+
+  struct Buffer {
+    // position of the next clause to be published
+    std::atomic<uint64_t> head;
+    Slot slots[SLOTS];
+  };
+
+  static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+      "atomics in memory shared between processes must be lock-free");
+
+  ClauseExchange(Buffer* buffer);
+
+  bool encode(Clause* cl);
+  bool encodeTerm(TermList t, bool sort);
+  Clause* decode(const uint32_t* words, unsigned length);
+  bool decodeTerm(const uint32_t*& words, const uint32_t* end, bool sort, TermList& res);
+  static uint32_t checksum(uint64_t position, const uint32_t* words, unsigned length);
+
+  static ClauseExchange* s_instance;
+
+  Buffer* _buffer;
+  // the number of symbols present in the parent when the exchange was created
+  unsigned _functions;
+  unsigned _predicates;
+  unsigned _typeCons;
+  // the position up to which this process has imported
+  uint64_t _next;
+
+  // scratch space for encoding and decoding
+  Stack<uint32_t> _words;
+};
+
+}
+
+#endif // __ClauseExchange__
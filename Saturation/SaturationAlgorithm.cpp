@@ -13,6 +13,7 @@
  */
 #include "Debug/RuntimeStatistics.hpp"
 
+#include "Lib/Allocator.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Metaiterators.hpp"
@@ -23,6 +24,7 @@
 #include "Lib/System.hpp"
 
 #include "Indexing/LiteralIndexingStructure.hpp"
+#include "Indexing/TermSharing.hpp"
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/ColorHelper.hpp"
@@ -102,6 +104,7 @@
 
 #include "Splitter.hpp"
 
+#include "ClauseExchange.hpp"
 #include "ConsequenceFinder.hpp"
 #include "LabelFinder.hpp"
 #include "Splitter.hpp"
@@ -210,6 +213,7 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _fwSimplifiers(0), _simplifiers(0), _bwSimplifiers(0), _splitter(0),
     _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
     _instantiation(0), _fnDefHandler(prb.getFunctionDefinitionHandler()),
+    _clauseExchange(ClauseExchange::tryGetInstance(prb, opt)),
     _generatedClauseCount(0),
     _activationLimit(0)
 {
@@ -217,6 +221,15 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
 
   _activationLimit = opt.activationLimit();
 
+  if (opt.termCollectionThreshold()) {
+    if (termCollectionSupported(prb, opt)) {
+      _termCollectionThreshold = size_t(opt.termCollectionThreshold()) * 1048576;
+    } else if (outputAllowed()) {
+      addCommentSignForSZS(std::cout);
+      std::cout << "WARNING: term collection is not supported with the current problem and options, ignoring term_collection_threshold." << endl;
+    }
+  }
+
   _ordering = OrderingSP(Ordering::create(prb, opt));
   if (!Ordering::trySetGlobalOrdering(_ordering)) {
     // this is not an error, it may just lead to lower performance (and most likely not significantly lower)
@@ -319,6 +332,7 @@ void SaturationAlgorithm::tryUpdateFinalClauseCount()
   if (inst->_extensionality != 0) {
     env.statistics->finalExtensionalityClauses = inst->_extensionality->size();
   }
+  inst->_imgr->updateStatistics();
 }
 
 /**
@@ -856,6 +870,7 @@ void SaturationAlgorithm::addUnprocessedClause(Clause* cl)
 {
   _generatedClauseCount++;
   env.statistics->generatedClauses++;
+  Timer::publishProgress();
 
   cl=doImmediateSimplification(cl);
   if (!cl) {
@@ -1006,6 +1021,9 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
 
     BwSimplificationRecordIterator simplifications;
     bse->perform(cl, simplifications);
+    // the simplification records are already collected, so the removals
+    // from the indices can be postponed until all of them are processed
+    startIndexBatch();
     while (simplifications.hasNext()) {
       BwSimplificationRecord srec = simplifications.next();
       Clause *redundant = srec.toRemove;
@@ -1028,6 +1046,33 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
 
       redundant->decRefCnt();
     }
+    endIndexBatch();
+  }
+}
+
+/**
+ * Start a batch of index updates, cf. IndexManager::startBatch()
+ *
+ * The clauses added to and removed from the containers until the matching
+ * endIndexBatch() enter and leave the indices together, which is cheaper
+ * e.g. when AVATAR backtracking removes many clauses at once. The indices
+ * must not be traversed while the batch is open, as queries apply the
+ * postponed updates.
+ */
+void SaturationAlgorithm::startIndexBatch()
+{
+  _indexBatchDepth++;
+  _imgr->startBatch();
+}
+
+void SaturationAlgorithm::endIndexBatch()
+{
+  ASS_G(_indexBatchDepth, 0);
+  _imgr->endBatch();
+  if (--_indexBatchDepth == 0) {
+    while (_batchRemovedClauses.isNonEmpty()) {
+      _batchRemovedClauses.pop()->decRefCnt();
+    }
   }
 }
 
@@ -1050,6 +1095,12 @@ void SaturationAlgorithm::removeActiveOrPassiveClause(Clause* cl)
     return;
   }
 
+  if (_indexBatchDepth) {
+    // the indices refer to the clause until the batch is applied
+    cl->incRefCnt();
+    _batchRemovedClauses.push(cl);
+  }
+
   switch (cl->store()) {
     case Clause::PASSIVE: {
       TIME_TRACE(TimeTrace::PASSIVE_CONTAINER_MAINTENANCE);
@@ -1138,7 +1189,14 @@ void SaturationAlgorithm::activate(Clause* cl)
   ASS_EQ(cl->store(), Clause::SELECTED);
   cl->setStore(Clause::ACTIVE);
   env.statistics->activeClauses++;
+  // the literals and subterms of cl enter the indices as one batch
+  startIndexBatch();
   _active->add(cl);
+  endIndexBatch();
+
+  if (_clauseExchange && _clauseExchange->publish(cl)) {
+    env.statistics->exportedClauses++;
+  }
 
   _conditionalRedundancyHandler->checkEquations(cl);
 
@@ -1170,6 +1228,7 @@ void SaturationAlgorithm::activate(Clause* cl)
 
     Shuffling::shuffleArray(_postponedClauseRemovals.begin(), _postponedClauseRemovals.size());
   }
+  startIndexBatch();
   while (_postponedClauseRemovals.isNonEmpty()) {
     Clause* cl = _postponedClauseRemovals.pop();
     if (cl->store() != Clause::ACTIVE && cl->store() != Clause::PASSIVE) {
@@ -1178,6 +1237,7 @@ void SaturationAlgorithm::activate(Clause* cl)
     TIME_TRACE("clause removal")
     removeActiveOrPassiveClause(cl);
   }
+  endIndexBatch();
 
   if (generated.premiseRedundant) {
     _active->remove(cl);
@@ -1259,6 +1319,14 @@ UnitList *SaturationAlgorithm::collectSaturatedSet()
  */
 void SaturationAlgorithm::doOneAlgorithmStep()
 {
+  if (_clauseExchange) {
+    _clauseExchange->import(_importedClauses);
+    while (_importedClauses.isNonEmpty()) {
+      env.statistics->importedClauses++;
+      addNewClause(_importedClauses.pop());
+    }
+  }
+
   doUnprocessedLoop();
 
   if (_passive->isEmpty()) {
@@ -1305,24 +1373,76 @@ MainLoopResult SaturationAlgorithm::runImpl()
 
   // could be more precise, but we don't care too much
   unsigned startTime = Timer::elapsedDeciseconds();
+  unsigned nextReclaim = startTime + RECLAIM_PERIOD;
+  if (_termCollectionThreshold) {
+    env.sharing->startCollection();
+  }
   try {
     for (;; l++) {
       if (_activationLimit && l > _activationLimit) {
         throw ActivationLimitExceededException();
       }
-      if(_softTimeLimit && Timer::elapsedDeciseconds() - startTime > _softTimeLimit)
+      unsigned now = Timer::elapsedDeciseconds();
+      if(_softTimeLimit && now - startTime > _softTimeLimit)
         throw TimeLimitExceededException();
+      if (now >= nextReclaim) {
+        // give memory of deleted clauses, terms, ... back to the system
+        Lib::reclaimMemory();
+        nextReclaim = now + RECLAIM_PERIOD;
+      }
+      if (System::allocationReportRequested()) {
+        env.statistics->printAllocations(std::cout);
+      }
+      if (_termCollectionThreshold && Lib::smallObjectMemory() > _termCollectionThreshold) {
+        collectTerms();
+      }
 
       doOneAlgorithmStep();
       env.statistics->activations = l;
+      Timer::publishProgress();
     }
   }
   catch (ThrowableBase&) {
+    if (_termCollectionThreshold) {
+      // keep the terms for the proof and whatever else follows
+      env.sharing->stopCollection();
+    }
     tryUpdateFinalClauseCount();
     throw;
   }
 }
 
+/**
+ * True if the terms the saturation no longer uses can be collected, see TermSharing::startCollection().
+ * They cannot when some inference or preprocessing keeps terms in a structure of its own,
+ * such as the caches of arithmetic normalisation or the SAT solver of global subsumption.
+ */
+bool SaturationAlgorithm::termCollectionSupported(Problem& prb, const Options& opt)
+{
+  return !prb.hasInterpretedOperations() &&
+    !prb.isHigherOrder() &&
+    !env.signature->hasTermAlgebras() &&
+    opt.induction() == Options::Induction::NONE &&
+    !opt.functionDefinitionIntroduction() &&
+    !opt.globalSubsumption() &&
+    !opt.conditionalRedundancyCheck() &&
+    opt.splittingCongruenceClosure() == Options::SplittingCongruenceClosure::OFF &&
+    opt.questionAnswering() == Options::QuestionAnsweringMode::OFF &&
+    opt.proofExtra() != Options::ProofExtra::FULL;
+}
+
+/**
+ * Destroy the terms that became unreachable, give the memory back to the system
+ * and make sure the next collection waits until the memory in use doubles
+ */
+void SaturationAlgorithm::collectTerms()
+{
+  env.statistics->termCollections++;
+  env.statistics->collectedTerms += env.sharing->collect();
+  Lib::reclaimMemory();
+  _termCollectionThreshold = std::max(_termCollectionThreshold, 2 * Lib::smallObjectMemory());
+}
+
 /**
  * Assign an generating inference object @b generator to be used
  *
@@ -1604,7 +1724,7 @@ SaturationAlgorithm *SaturationAlgorithm::createFromOptions(Problem& prb, const
   }
 
   if (opt.forwardSubsumption()) {
-    if (opt.codeTreeSubsumption()) {
+    if (opt.codeTreeSubsumption() && !opt.featureVectorSubsumption()) {
       res->addForwardSimplifierToFront(new CodeTreeForwardSubsumptionAndResolution(opt.forwardSubsumptionResolution()));
     } else {
       res->addForwardSimplifierToFront(new ForwardSubsumptionAndResolution(opt.forwardSubsumptionResolution()));
@@ -85,6 +85,9 @@ public:
 
   void removeActiveOrPassiveClause(Clause* cl);
 
+  void startIndexBatch();
+  void endIndexBatch();
+
   //Run when clause cl has been simplified. Replacement is the array of replacing
   //clauses which can be empty
   void onClauseReduction(Clause* cl, Clause** replacements, unsigned numOfReplacements, 
@@ -188,6 +191,11 @@ protected:
 
   ClauseStack _postponedClauseRemovals;
 
+  /** nesting depth of the index batches, cf. startIndexBatch() */
+  unsigned _indexBatchDepth = 0;
+  /** clauses removed during an index batch, kept alive until it is applied */
+  ClauseStack _batchRemovedClauses;
+
   UnprocessedClauseContainer* _unprocessed;
   std::unique_ptr<PassiveClauseContainer> _passive;
   ActiveClauseContainer* _active;
@@ -221,6 +229,9 @@ protected:
   Instantiation* _instantiation;
   FunctionDefinitionHandler& _fnDefHandler;
   std::unique_ptr<ConditionalRedundancyHandler> _conditionalRedundancyHandler;
+  // clauses shared with the other portfolio slices, or nullptr
+  ClauseExchange* _clauseExchange;
+  ClauseStack _importedClauses;
 
   SubscriptionData _passiveContRemovalSData;
   SubscriptionData _activeContRemovalSData;
@@ -243,8 +254,15 @@ protected:
 private:
   static ImmediateSimplificationEngine* createISE(Problem& prb, const Options& opt, Ordering& ordering);
 
+  static bool termCollectionSupported(Problem& prb, const Options& opt);
+  void collectTerms();
+
   // a "soft" time limit in deciseconds, checked manually: 0 is no limit
   unsigned _softTimeLimit = 0;
+  // collect the unreachable terms when small objects take more memory than this (in bytes): 0 is never
+  size_t _termCollectionThreshold = 0;
+  // how often (in deciseconds) the main loop returns free memory to the system
+  static const unsigned RECLAIM_PERIOD = 10;
 };
 
 
@@ -1704,6 +1704,10 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
   
   SplitSet* backtracked = SplitSet::getFromArray(toRemove.begin(), toRemove.size());
 
+  // the removals from the indices are applied together once all the
+  // children are removed
+  _sa->startIndexBatch();
+
   // ensure all children are backtracked
   // i.e. removed from _sa and reference counter dec
   auto blit = backtracked->iter();
@@ -1739,6 +1743,7 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
       cr->release();
     }
   }
+  _sa->endIndexBatch();
 
   // perform unfreezing  
     
@@ -96,6 +96,13 @@ void Options::init()
     _memoryLimit.description="Attempt to limit memory use (in MB). Limits less than 20MB are ignored to allow Vampire to start. Known not to work on MacOS for mysterious reasons: https://forums.developer.apple.com/forums/thread/702803";
     _lookup.insert(&_memoryLimit);
 
+    _hugePages = BoolOptionValue("huge_pages","",false);
+    _hugePages.description="Back the memory of small objects (terms, clauses, index nodes, ...) by 2MB transparent huge pages, "
+      "with separate arenas for each object size, to reduce TLB misses on large problems. "
+      "Takes effect only if the system has transparent huge pages enabled (in madvise or always mode).";
+    _lookup.insert(&_hugePages);
+    _hugePages.tag(OptionTag::DEVELOPMENT);
+
 #if VAMPIRE_PERF_EXISTS
   _instructionLimit = UnsignedOptionValue("instruction_limit","i",0);
   _instructionLimit.description="Limit the number (in millions) of executed instructions (excluding the kernel ones).";
@@ -119,6 +126,16 @@ void Options::init()
     _interactive.setExperimental();
     _lookup.insert(&_interactive);
 
+    _server = StringOptionValue("server","","");
+    _server.description = "An experimental server mode for solving many problems with a single start-up: "
+      "accept jobs on the Unix socket at the given path, or on standard input if the path is -. "
+      "A job is a line with the length of the problem in bytes followed by the options to use, "
+      "and then the problem itself. Every job is solved in a fresh child process, which writes its output "
+      "to the connection (closed afterwards) or to standard output (followed by the line '% end of job <exit code>'). "
+      "The memory limit of the server is a hard limit, which the jobs can lower but not raise.";
+    _server.setExperimental();
+    _lookup.insert(&_server);
+
     _mode = ChoiceOptionValue<Mode>("mode","",Mode::VAMPIRE,
                                     {"axiom_selection",
                                         "casc",
@@ -209,6 +226,69 @@ void Options::init()
     _lookup.insert(&_randomizSeedForPortfolioWorkers);
     _randomizSeedForPortfolioWorkers.onlyUsefulWith(UsingPortfolioTechnology());
 
+    _portfolioZygotes = BoolOptionValue("portfolio_zygotes","pzyg",false);
+    _portfolioZygotes.description = "In portfolio mode, preprocess the problem once for every distinct setting of the preprocessing options "
+      "in a dedicated process, and start the slices sharing that setting from this process (Linux only).";
+    _lookup.insert(&_portfolioZygotes);
+    _portfolioZygotes.onlyUsefulWith(UsingPortfolioTechnology());
+    _portfolioZygotes.tag(OptionTag::DEVELOPMENT);
+
+    _portfolioClauseExchange = BoolOptionValue("portfolio_clause_exchange","pce",false);
+    _portfolioClauseExchange.description = "In portfolio mode, let the slices publish light clauses which do not depend on AVATAR splits "
+      "into a buffer shared by all slices, from which the other slices import them as axioms. "
+      "Only clauses over the symbols of the input problem (i.e. not introduced by a slice's preprocessing) are exchanged.";
+    _lookup.insert(&_portfolioClauseExchange);
+    _portfolioClauseExchange.onlyUsefulWith(UsingPortfolioTechnology());
+    _portfolioClauseExchange.tag(OptionTag::DEVELOPMENT);
+
+    _portfolioClauseExchangeWeight = UnsignedOptionValue("portfolio_clause_exchange_weight","pcew",8);
+    _portfolioClauseExchangeWeight.description = "The maximal weight of a clause published with portfolio_clause_exchange.";
+    _lookup.insert(&_portfolioClauseExchangeWeight);
+    _portfolioClauseExchangeWeight.onlyUsefulWith(_portfolioClauseExchange.is(equal(true)));
+    _portfolioClauseExchangeWeight.tag(OptionTag::DEVELOPMENT);
+
+    _portfolioSuspend = BoolOptionValue("portfolio_suspend","psus",false);
+    _portfolioSuspend.description = "In portfolio mode, a slice that reaches its time (or instruction) limit is stopped rather than terminated. "
+      "When the schedule is repeated with extended limits, the stopped slice is resumed instead of being started again from scratch.";
+    _lookup.insert(&_portfolioSuspend);
+    _portfolioSuspend.onlyUsefulWith(UsingPortfolioTechnology());
+    _portfolioSuspend.tag(OptionTag::DEVELOPMENT);
+
+    _portfolioSuspendMemory = UnsignedOptionValue("portfolio_suspend_memory","psusm",4096);
+    _portfolioSuspendMemory.description = "The total memory (in MB) that stopped slices may occupy when portfolio_suspend is on. "
+      "A stopped slice that does not fit is terminated and will be restarted from scratch. 0 means no limit.";
+    _lookup.insert(&_portfolioSuspendMemory);
+    _portfolioSuspendMemory.onlyUsefulWith(_portfolioSuspend.is(equal(true)));
+    _portfolioSuspendMemory.tag(OptionTag::DEVELOPMENT);
+
+    _portfolioMemoryBudget = UnsignedOptionValue("portfolio_memory_budget","pmb",0);
+    _portfolioMemoryBudget.description = "The total memory (in MB) that the slices of a portfolio run may occupy together. "
+      "No new slice is started while the next one would be expected not to fit, and when the budget is exceeded "
+      "the largest stopped slice (see portfolio_suspend) or else the running slice occupying the most memory "
+      "for the fewest recent activations (as far as known, see portfolio_preemption) is terminated. "
+      "The zygotes (see portfolio_zygotes) count towards the budget. "
+      "Memory is measured as the proportional set size (Pss) of every process, which splits the pages shared "
+      "between processes (e.g. a zygote's preprocessed problem) among them, or as the resident size less the shared pages "
+      "where the kernel does not report it. 0 means no budget.";
+    _lookup.insert(&_portfolioMemoryBudget);
+    _portfolioMemoryBudget.onlyUsefulWith(UsingPortfolioTechnology());
+    _portfolioMemoryBudget.tag(OptionTag::DEVELOPMENT);
+
+    _portfolioPreemption = BoolOptionValue("portfolio_preemption","ppre",false);
+    _portfolioPreemption.description = "In portfolio mode, let the slices report their progress to the parent, "
+      "which terminates slices that are clearly stuck to start the next slices of the schedule earlier. "
+      "A slice is stuck if it neither activated, retained nor generated a clause during three portfolio_preemption_windows in a row, "
+      "or if its passive set keeps growing while it uses more than three quarters of the memory limit.";
+    _lookup.insert(&_portfolioPreemption);
+    _portfolioPreemption.onlyUsefulWith(UsingPortfolioTechnology());
+    _portfolioPreemption.tag(OptionTag::DEVELOPMENT);
+
+    _portfolioPreemptionWindow = UnsignedOptionValue("portfolio_preemption_window","pprew",50);
+    _portfolioPreemptionWindow.description = "The time (in deciseconds) over which a slice has to be stuck to be terminated with portfolio_preemption.";
+    _lookup.insert(&_portfolioPreemptionWindow);
+    _portfolioPreemptionWindow.onlyUsefulWith(_portfolioPreemption.is(equal(true)));
+    _portfolioPreemptionWindow.tag(OptionTag::DEVELOPMENT);
+
     _decode = DecodeOptionValue("decode","",this);
     _decode.description="Decodes an encoded strategy. Can be used to replay a strategy. To make Vampire output an encoded version of the strategy use the encode option.";
     _lookup.insert(&_decode);
@@ -499,6 +579,14 @@ void Options::init()
     _codeTreeSubsumption.setExperimental();
     _lookup.insert(&_codeTreeSubsumption);
 
+    _featureVectorSubsumption = BoolOptionValue("feature_vector_subsumption", "fvs", false);
+    _featureVectorSubsumption.description =
+      "Retrieve the candidates for multi-literal forward and backward subsumption from a feature vector index "
+      "over clauses instead of from literal indices. Forward subsumption then does not use code trees.";
+    _featureVectorSubsumption.tag(OptionTag::INFERENCES);
+    _featureVectorSubsumption.setExperimental();
+    _lookup.insert(&_featureVectorSubsumption);
+
     _generalSplitting = BoolOptionValue("general_splitting","gsp",false);
     _generalSplitting.description=
     "Splits clauses in order to reduce number of different variables in each clause. "
@@ -1596,6 +1684,38 @@ void Options::init()
     _demodulationOnlyEquational.onlyUsefulWith(Or(_forwardDemodulation.is(notEqual(Demodulation::OFF)),_backwardDemodulation.is(notEqual(Demodulation::OFF))));
     _demodulationOnlyEquational.addProblemConstraint(hasEquality());
 
+    _forwardDemodulationNormalForm = BoolOptionValue("forward_demodulation_normal_form","fdnf",false);
+    _forwardDemodulationNormalForm.description=
+       "Rewrite a clause to its normal form w.r.t. the demodulators in a single forward demodulation instead of "
+       "performing one rewrite at a time, which creates only the final clause. Has no effect with combinatory "
+       "superposition or symbol colours.";
+    _lookup.insert(&_forwardDemodulationNormalForm);
+    _forwardDemodulationNormalForm.setExperimental();
+    _forwardDemodulationNormalForm.tag(OptionTag::INFERENCES);
+    _forwardDemodulationNormalForm.onlyUsefulWith(ProperSaturationAlgorithm());
+    _forwardDemodulationNormalForm.onlyUsefulWith(_forwardDemodulation.is(notEqual(Demodulation::OFF)));
+    _forwardDemodulationNormalForm.addProblemConstraint(hasEquality());
+
+    _fingerprintIndexing = ChoiceOptionValue<FingerprintIndexing>("fingerprint_indexing","fpi",FingerprintIndexing::OFF,{"off","superposition","demodulation","all"});
+    _fingerprintIndexing.description =
+      "Use fingerprint indexing instead of substitution trees for the subterm and left-hand side indices "
+      "of superposition (and of sub-variable superposition), for the subterm index of backward demodulation, or for all of them.";
+    _fingerprintIndexing.tag(OptionTag::INFERENCES);
+    _fingerprintIndexing.setExperimental();
+    _fingerprintIndexing.onlyUsefulWith(ProperSaturationAlgorithm());
+    _fingerprintIndexing.addProblemConstraint(hasEquality());
+    _lookup.insert(&_fingerprintIndexing);
+
+    _retrievalCache = BoolOptionValue("retrieval_cache","rtc",false);
+    _retrievalCache.description =
+      "Remember the queries for which a term or literal index retrieved nothing, until the next clause is added to the index. "
+      "Repeated queries, such as forward demodulation of frequent subterms which have no generalisation, "
+      "are then answered without traversing the index.";
+    _retrievalCache.tag(OptionTag::INFERENCES);
+    _retrievalCache.setExperimental();
+    _retrievalCache.onlyUsefulWith(ProperSaturationAlgorithm());
+    _lookup.insert(&_retrievalCache);
+
     _extensionalityAllowPosEq = BoolOptionValue( "extensionality_allow_pos_eq","erape",false);
     _extensionalityAllowPosEq.description="If extensionality resolution equals filter, this dictates"
       " whether we allow other positive equalities when recognising extensionality clauses";
@@ -2249,6 +2369,15 @@ void Options::init()
     _lookup.insert(&_activationLimit);
     _activationLimit.tag(OptionTag::SATURATION);
 
+    _termCollectionThreshold = UnsignedOptionValue("term_collection_threshold","tct",0);
+    _termCollectionThreshold.description="Destroy the terms created during saturation that are no longer reachable "
+      "from any clause or index whenever the memory of small objects exceeds this many MB, "
+      "after which the threshold grows to twice the memory still in use. 0 means never. "
+      "Ignored with induction, theory reasoning and a few other features keeping terms elsewhere.";
+    _termCollectionThreshold.onlyUsefulWith(ProperSaturationAlgorithm());
+    _lookup.insert(&_termCollectionThreshold);
+    _termCollectionThreshold.tag(OptionTag::SATURATION);
+
     _termOrdering = ChoiceOptionValue<TermOrdering>("term_ordering","to", TermOrdering::KBO,
                                                     {"kbo","lpo"});
     _termOrdering.description="The term ordering used by Vampire to orient equations and order literals";
@@ -2256,6 +2385,16 @@ void Options::init()
     _termOrdering.tag(OptionTag::SATURATION);
     _lookup.insert(&_termOrdering);
 
+    _orderingCache = UnsignedOptionValue("ordering_cache","oc",0);
+    _orderingCache.description="Cache the results of comparing shared terms and literals by the term ordering "
+      "in a table of 2^n entries, where n is the value of this option (0 means no cache). "
+      "Values above 24 are not allowed.";
+    _orderingCache.addHardConstraint(lessThan(25u));
+    _orderingCache.setExperimental();
+    _orderingCache.onlyUsefulWith(ProperSaturationAlgorithm());
+    _orderingCache.tag(OptionTag::SATURATION);
+    _lookup.insert(&_orderingCache);
+
     _symbolPrecedence = ChoiceOptionValue<SymbolPrecedence>("symbol_precedence","sp",SymbolPrecedence::ARITY,
                                                             {"arity","occurrence","reverse_arity","unary_first",
                                                             "const_max", "const_min",
@@ -2290,6 +2429,14 @@ void Options::init()
     _kboWeightGenerationScheme.tag(OptionTag::SATURATION);
     _lookup.insert(&_kboWeightGenerationScheme);
 
+    _kboFlatComparison = BoolOptionValue("kbo_flat_comparison","kfc",false);
+    _kboFlatComparison.setExperimental();
+    _kboFlatComparison.onlyUsefulWith(_termOrdering.is(equal(TermOrdering::KBO)));
+    _kboFlatComparison.tag(OptionTag::SATURATION);
+    _kboFlatComparison.description="Compare terms by KBO over their flattened forms, counting variables in a dense array rather than a hash map. "
+      "Only affects comparisons of terms without a substitution applied to them.";
+    _lookup.insert(&_kboFlatComparison);
+
     _kboMaxZero = BoolOptionValue("kbo_max_zero","kmz",false);
     _kboMaxZero.setExperimental();
     _kboMaxZero.onlyUsefulWith(_termOrdering.is(equal(TermOrdering::KBO)));
@@ -3462,6 +3609,44 @@ std::string Options::generateEncodedOptions() const
 }
 
 
+/**
+ * Return a string such that two option sets with the same (non-empty) string
+ * turn a given problem into the same clauses by Shell::Preprocess,
+ * which makes it possible to preprocess once and saturate many times.
+ *
+ * The empty string is returned if the outcome of preprocessing depends on randomness.
+ */
+std::string Options::preprocessingFingerprint() const
+{
+  if (shuffleInput() || randomPolarities() || randomTraversals()) {
+    return "";
+  }
+
+  // options read by Preprocess and the classes it relies on,
+  // including the ones influencing the inferences recorded for the preprocessed units
+  const AbstractOptionValue* relevant[] = {
+    &_arityCheck, &_addCombAxioms, &_addProxyAxioms, &_blockedClauseElimination, &_cases, &_casesSimp,
+    &_choiceAxiom, &_choiceReasoning, &_clausificationOnTheFly, &_combinatorySuperposition,
+    &_distinctGroupExpansionLimit, &_equalityProxy, &_equalityResolutionWithDeletion,
+    &_equalityToEquivalence, &_FOOLParamodulation, &_functionDefinitionElimination, &_functionExtensionality,
+    &_generalSplitting, &_guessTheGoal, &_guessTheGoalLimit, &_ignoreConjectureInPreprocessing,
+    &_induction, &_inequalitySplitting, &_inlineLet, &_maximumXXNarrows, &_naming, &_newCNF,
+    &_printClausifierPremises, &_priortyToLongReducts, &_proofExtra, &_protectedPrefix,
+    &_questionAnswering, &_questionAnsweringGroundOnly, &_saturationAlgorithm, &_sineDepth,
+    &_sineGeneralityThreshold, &_sineSelection, &_sineToAge, &_sineToAgeGeneralityThreshold,
+    &_sineToAgeTolerance, &_sineToPredLevels, &_sineTolerance, &_termAlgebraCyclicityCheck,
+    &_termAlgebraExhaustivenessAxiom, &_theoryAxioms, &_theoryFlattening, &_theorySplitQueueExpectedRatioDenom,
+    &_tweeGoalTransformation, &_unusedPredicateDefinitionRemoval, &_useACeval, &_useMonoEqualityProxy,
+    &_useSineLevelSplitQueues,
+  };
+
+  std::ostringstream res;
+  for (auto option : relevant) {
+    res << option->longName << "=" << option->getStringOfActual() << ":";
+  }
+  return res.str();
+}
+
 /**
  * True if the options are complete.
  * @since 23/07/2011 Manchester
@@ -129,6 +129,8 @@ public:
     void readFromEncodedOptions (std::string testId);
     void readOptionsString (std::string testId,bool assign=true);
     std::string generateEncodedOptions() const;
+    // identifies the outcome of Shell::Preprocess, see portfolio_zygotes
+    std::string preprocessingFingerprint() const;
 
     // deal with completeness
     bool complete(const Problem&) const;
@@ -514,6 +516,13 @@ public:
     ON = 2
   };
 
+  /** Which term indices use fingerprint indexing instead of substitution trees */
+  enum class FingerprintIndexing : unsigned int {
+    OFF,
+    SUPERPOSITION,
+    DEMODULATION,
+    ALL
+  };
   enum class Demodulation : unsigned int {
     ALL = 0,
     OFF = 1,
@@ -1991,6 +2000,7 @@ public:
   std::string inputFile() const { return _inputFile.actualValue; }
   void resetInputFile() { _inputFile.actualValue = ""; }
   int activationLimit() const { return _activationLimit.actualValue; }
+  unsigned termCollectionThreshold() const { return _termCollectionThreshold.actualValue; }
   unsigned randomSeed() const { return _randomSeed.actualValue; }
   void setRandomSeed(unsigned seed) { _randomSeed.actualValue = seed; }
   const std::string& strategySamplerFilename() const { return _sampleStrategy.actualValue; }
@@ -2087,6 +2097,7 @@ public:
   DemodulationRedundancyCheck demodulationRedundancyCheck() const { return _demodulationRedundancyCheck.actualValue; }
   bool demodulationPrecompiledComparison() const { return _demodulationPrecompiledComparison.actualValue; }
   bool demodulationOnlyEquational() const { return _demodulationOnlyEquational.actualValue; }
+  bool forwardDemodulationNormalForm() const { return _forwardDemodulationNormalForm.actualValue; }
 
   //void setBackwardDemodulation(Demodulation newVal) { _backwardDemodulation = newVal; }
   Subsumption backwardSubsumption() const { return _backwardSubsumption.actualValue; }
@@ -2108,6 +2119,8 @@ public:
   IntroducedSymbolPrecedence introducedSymbolPrecedence() const { return _introducedSymbolPrecedence.actualValue; }
   KboWeightGenerationScheme kboWeightGenerationScheme() const { return _kboWeightGenerationScheme.actualValue; }
   bool kboMaxZero() const { return _kboMaxZero.actualValue; }
+  bool kboFlatComparison() const { return _kboFlatComparison.actualValue; }
+  unsigned orderingCache() const { return _orderingCache.actualValue; }
   const KboAdmissibilityCheck kboAdmissabilityCheck() const { return _kboAdmissabilityCheck.actualValue; }
   const std::string& functionWeights() const { return _functionWeights.actualValue; }
   const std::string& predicateWeights() const { return _predicateWeights.actualValue; }
@@ -2118,6 +2131,7 @@ public:
   int timeLimitInDeciseconds() const { return _timeLimitInDeciseconds.actualValue; }
   size_t memoryLimit() const { return _memoryLimit.actualValue; }
   void setMemoryLimitOptionValue(size_t newVal) { _memoryLimit.actualValue = newVal; }
+  bool hugePages() const { return _hugePages.actualValue; }
 #if VAMPIRE_PERF_EXISTS
   unsigned instructionLimit() const { return _instructionLimit.actualValue; }
   void setInstructionLimit(unsigned newVal) { _instructionLimit.actualValue = newVal; }
@@ -2127,6 +2141,8 @@ public:
 #endif
   bool interactive() const { return _interactive.actualValue; }
   void setInteractive(bool v) { _interactive.actualValue = v; }
+  const std::string& server() const { return _server.actualValue; }
+  void setServer(std::string v) { _server.actualValue = v; }
   int inequalitySplitting() const { return _inequalitySplitting.actualValue; }
   int ageRatio() const { return _ageWeightRatio.actualValue; }
   void setAgeRatio(int v){ _ageWeightRatio.actualValue = v; }
@@ -2176,6 +2192,14 @@ public:
   bool randomTraversals() const { return _randomTraversals.actualValue; }
   bool randomizeSeedForPortfolioWorkers() const { return _randomizSeedForPortfolioWorkers.actualValue; }
   void setRandomizeSeedForPortfolioWorkers(bool val) { _randomizSeedForPortfolioWorkers.actualValue = val; }
+  bool portfolioZygotes() const { return _portfolioZygotes.actualValue; }
+  bool portfolioClauseExchange() const { return _portfolioClauseExchange.actualValue; }
+  unsigned portfolioClauseExchangeWeight() const { return _portfolioClauseExchangeWeight.actualValue; }
+  bool portfolioSuspend() const { return _portfolioSuspend.actualValue; }
+  unsigned portfolioSuspendMemory() const { return _portfolioSuspendMemory.actualValue; }
+  unsigned portfolioMemoryBudget() const { return _portfolioMemoryBudget.actualValue; }
+  bool portfolioPreemption() const { return _portfolioPreemption.actualValue; }
+  unsigned portfolioPreemptionWindow() const { return _portfolioPreemptionWindow.actualValue; }
 
   bool ignoreConjectureInPreprocessing() const {return _ignoreConjectureInPreprocessing.actualValue;}
 
@@ -2183,6 +2207,9 @@ public:
   unsigned functionDefinitionIntroduction() const { return _functionDefinitionIntroduction.actualValue; }
   TweeGoalTransformation tweeGoalTransformation() const { return _tweeGoalTransformation.actualValue; }
   bool codeTreeSubsumption() const { return _codeTreeSubsumption.actualValue; }
+  bool featureVectorSubsumption() const { return _featureVectorSubsumption.actualValue; }
+  FingerprintIndexing fingerprintIndexing() const { return _fingerprintIndexing.actualValue; }
+  bool retrievalCache() const { return _retrievalCache.actualValue; }
   bool outputAxiomNames() const { return _outputAxiomNames.actualValue; }
   void setOutputAxiomNames(bool newVal) { _outputAxiomNames.actualValue = newVal; }
   QuestionAnsweringMode questionAnswering() const { return _questionAnswering.actualValue; }
@@ -2452,6 +2479,7 @@ private:
   ChoiceOptionValue<DemodulationRedundancyCheck> _demodulationRedundancyCheck;
   BoolOptionValue _demodulationPrecompiledComparison;
   BoolOptionValue _demodulationOnlyEquational;
+  BoolOptionValue _forwardDemodulationNormalForm;
 
   ChoiceOptionValue<EqualityProxy> _equalityProxy;
   BoolOptionValue _useMonoEqualityProxy;
@@ -2493,6 +2521,9 @@ private:
   UnsignedOptionValue _functionDefinitionIntroduction;
   ChoiceOptionValue<TweeGoalTransformation> _tweeGoalTransformation;
   BoolOptionValue _codeTreeSubsumption;
+  BoolOptionValue _featureVectorSubsumption;
+  ChoiceOptionValue<FingerprintIndexing> _fingerprintIndexing;
+  BoolOptionValue _retrievalCache;
 
   BoolOptionValue _generalSplitting;
   BoolOptionValue _globalSubsumption;
@@ -2563,8 +2594,10 @@ private:
 #endif
 
   UnsignedOptionValue _memoryLimit; // should be size_t, making an assumption
+  BoolOptionValue _hugePages;
 
   BoolOptionValue _interactive;
+  StringOptionValue _server;
 
   ChoiceOptionValue<Mode> _mode;
   ChoiceOptionValue<Schedule> _schedule;
@@ -2572,6 +2605,14 @@ private:
   UnsignedOptionValue _multicore;
   FloatOptionValue _slowness;
   BoolOptionValue _randomizSeedForPortfolioWorkers;
+  BoolOptionValue _portfolioZygotes;
+  BoolOptionValue _portfolioClauseExchange;
+  UnsignedOptionValue _portfolioClauseExchangeWeight;
+  BoolOptionValue _portfolioSuspend;
+  UnsignedOptionValue _portfolioSuspendMemory;
+  UnsignedOptionValue _portfolioMemoryBudget;
+  BoolOptionValue _portfolioPreemption;
+  UnsignedOptionValue _portfolioPreemptionWindow;
 
   IntOptionValue _naming;
   BoolOptionValue _nonliteralsInClauseWeight;
@@ -2600,6 +2641,7 @@ private:
   StringOptionValue _sampleStrategy;
 
   IntOptionValue _activationLimit;
+  UnsignedOptionValue _termCollectionThreshold;
 
   ChoiceOptionValue<SatSolver> _satSolver;
   ChoiceOptionValue<SaturationAlgorithm> _saturationAlgorithm;
@@ -2678,12 +2720,14 @@ private:
   ChoiceOptionValue<Statistics> _statistics;
   BoolOptionValue _superpositionFromVariables;
   ChoiceOptionValue<TermOrdering> _termOrdering;
+  UnsignedOptionValue _orderingCache;
   ChoiceOptionValue<SymbolPrecedence> _symbolPrecedence;
   ChoiceOptionValue<SymbolPrecedenceBoost> _symbolPrecedenceBoost;
   ChoiceOptionValue<IntroducedSymbolPrecedence> _introducedSymbolPrecedence;
   ChoiceOptionValue<EvaluationMode> _evaluationMode;
   ChoiceOptionValue<KboWeightGenerationScheme> _kboWeightGenerationScheme;
   BoolOptionValue _kboMaxZero;
+  BoolOptionValue _kboFlatComparison;
   ChoiceOptionValue<KboAdmissibilityCheck> _kboAdmissabilityCheck;
   StringOptionValue _functionWeights;
   StringOptionValue _predicateWeights;
@@ -18,7 +18,9 @@
 
 #include "Debug/RuntimeStatistics.hpp"
 
+#include "Lib/Allocator.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/Stack.hpp"
 #include "Lib/Timer.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
@@ -156,6 +158,8 @@ Statistics::Statistics()
     passiveClauses(0),
     activeClauses(0),
     extensionalityClauses(0),
+    exportedClauses(0),
+    importedClauses(0),
     discardedNonRedundantClauses(0),
     inferencesBlockedForOrderingAftercheck(0),
     smtReturnedUnknown(false),
@@ -164,6 +168,10 @@ Statistics::Statistics()
     finalPassiveClauses(0),
     finalActiveClauses(0),
     finalExtensionalityClauses(0),
+    termCollections(0),
+    collectedTerms(0),
+    orderingCacheHits(0),
+    orderingCacheMisses(0),
     splitClauses(0),
     splitComponents(0),
     uniqueComponents(0),
@@ -281,7 +289,7 @@ void Statistics::print(ostream& out)
   COND_OUT("Split inequalities", splitInequalities);
   SEPARATOR;
 
-  HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
+  HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+exportedClauses+importedClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
       discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
   COND_OUT("Initial clauses", initialClauses);
@@ -290,6 +298,8 @@ void Statistics::print(ostream& out)
   COND_OUT("Active clauses", activeClauses);
   COND_OUT("Passive clauses", passiveClauses);
   COND_OUT("Extensionality clauses", extensionalityClauses);
+  COND_OUT("Exported clauses", exportedClauses);
+  COND_OUT("Imported clauses", importedClauses);
   COND_OUT("Blocked clauses", blockedClauses);
   COND_OUT("Final active clauses", finalActiveClauses);
   COND_OUT("Final passive clauses", finalPassiveClauses);
@@ -297,6 +307,20 @@ void Statistics::print(ostream& out)
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
+  COND_OUT("Term collections", termCollections);
+  COND_OUT("Collected terms", collectedTerms);
+  COND_OUT("Ordering cache hits", orderingCacheHits);
+  COND_OUT("Ordering cache misses", orderingCacheMisses);
+  SEPARATOR;
+
+  HEADING("Indices", indices.size());
+  for (auto& [name, t] : indices) {
+    addCommentSignForSZS(out);
+    out << name << ": " << t.additions << " clauses added, " << t.removals << " removed, "
+        << t.queries << " queries (" << t.cacheHits << " cached), " << t.results << " results, "
+        << t.entries << " entries, " << t.nodes << " nodes, depth " << t.depth << endl;
+    separable = true;
+  }
   SEPARATOR;
 
 
@@ -460,6 +484,7 @@ void Statistics::print(ostream& out)
   COND_OUT("Pure propositional variables eliminated by SAT solver", satPureVarsEliminated);
   SEPARATOR;
 
+  printAllocations(out);
   }
 
   addCommentSignForSZS(out);
@@ -493,6 +518,49 @@ void Statistics::print(ostream& out)
 #endif // VTIME_PROFILING
 }
 
+#if ALLOCATOR_TELEMETRY && !defined(INDIVIDUAL_ALLOCATIONS)
+static void printAllocationCounts(ostream& out, const Lib::AllocationCounts& counts)
+{
+  out << counts.live << " live (" << counts.bytes << " bytes), peak "
+      << counts.peak << " (" << counts.peakBytes << " bytes)" << endl;
+}
+#endif
+
+void Statistics::printAllocations(ostream& out)
+{
+#if ALLOCATOR_TELEMETRY && !defined(INDIVIDUAL_ALLOCATIONS)
+  addCommentSignForSZS(out);
+  out << ">>> Allocations" << endl;
+  for (unsigned i = 0; i < SmallObjectAllocator::SIZE_CLASSES; i++) {
+    const AllocationCounts& counts = GLOBAL_SMALL_OBJECT_ALLOCATOR.sizeClassCounts(i);
+    if (!counts.peak) {
+      continue;
+    }
+    addCommentSignForSZS(out);
+    if (size_t bytes = SmallObjectAllocator::sizeClassBytes(i)) {
+      out << "Size class " << bytes << ": ";
+    } else {
+      out << "Larger objects: ";
+    }
+    printAllocationCounts(out, counts);
+  }
+
+  // the types taking the most memory first
+  Stack<const AllocationCounts*> types;
+  for (const AllocationCounts* counts = AllocationCounts::types(); counts; counts = counts->next) {
+    types.push(counts);
+  }
+  types.sort([](const AllocationCounts* a, const AllocationCounts* b) { return a->peakBytes > b->peakBytes; });
+  for (const AllocationCounts* counts : types) {
+    addCommentSignForSZS(out);
+    out << counts->name << ": ";
+    printAllocationCounts(out, *counts);
+  }
+  addCommentSignForSZS(out);
+  out << endl;
+#endif
+}
+
 const char* Statistics::phaseToString(ExecutionPhase p)
 {
   switch(p) {
@@ -18,6 +18,7 @@
 #define __Statistics__
 
 #include <ostream>
+#include <vector>
 
 #include "Forwards.hpp"
 #include "Debug/Assertion.hpp"
@@ -42,6 +43,8 @@ public:
 
   void print(std::ostream& out);
   void explainRefutationNotFound(std::ostream& out);
+  // the allocation telemetry, if compiled in (cf. ALLOCATOR_TELEMETRY)
+  void printAllocations(std::ostream& out);
 
   // Input
   /** number of input clauses */
@@ -244,6 +247,9 @@ public:
   unsigned activeClauses;
   /** all extensionality clauses */
   unsigned extensionalityClauses;
+  /** clauses published for / imported from other portfolio slices */
+  unsigned exportedClauses;
+  unsigned importedClauses;
 
   unsigned discardedNonRedundantClauses;
 
@@ -260,6 +266,31 @@ public:
   unsigned finalActiveClauses;
   /** extensionality clauses at the end of the saturation algorithm run */
   unsigned finalExtensionalityClauses;
+  /** collections of unreachable terms during saturation */
+  unsigned termCollections;
+  /** terms and literals destroyed by those */
+  unsigned long collectedTerms;
+  /** comparisons by the term ordering answered by its cache */
+  unsigned long orderingCacheHits;
+  /** comparisons by the term ordering not found in its cache */
+  unsigned long orderingCacheMisses;
+
+  /** Counters of one index, cf. Indexing::Index::telemetry() */
+  struct IndexTelemetry {
+    /** clauses added to and removed from the index */
+    unsigned long additions = 0;
+    unsigned long removals = 0;
+    /** queries, those answered by the retrieval cache, and results returned by them */
+    unsigned long queries = 0;
+    unsigned long cacheHits = 0;
+    unsigned long results = 0;
+    /** entries, nodes and depth of the indexing structure */
+    unsigned long entries = 0;
+    unsigned long nodes = 0;
+    unsigned depth = 0;
+  };
+  /** the telemetry of the indices of the saturation algorithm, by their names */
+  std::vector<std::pair<const char*, IndexTelemetry>> indices;
 
   unsigned splitClauses;
   unsigned splitComponents;
@@ -31,14 +31,39 @@ class SimplificationTester
 public:
   virtual Kernel::Clause* simplify(Kernel::Clause*) const = 0;
 
+  /**
+   * Simplify with the clauses of @b context available to the simplification (e.g. as demodulators),
+   * pushing those it used to @b premises. Only needed for simplifications with premises.
+   */
+  virtual Kernel::Clause* simplify(Kernel::Clause* cl, const Kernel::ClauseStack& context, Kernel::ClauseStack& premises) const
+  { return simplify(cl); }
+
   virtual bool eq(Kernel::Clause const* lhs, Kernel::Clause const* rhs) const 
   { return TestUtils::eqModAC(lhs, rhs); }
 };
 
+/**
+ * Checks that the premises used are (modulo SimplificationTester::eq) exactly the expected ones, if any are given.
+ */
+inline void checkPremises(const SimplificationTester& simpl, Kernel::Clause* input,
+    Option<Kernel::ClauseStack>& expected, Kernel::ClauseStack& premises)
+{
+  if (expected.isSome() &&
+      !TestUtils::permEq(expected.unwrap(), premises, [&](auto exp, auto is) { return simpl.eq(exp, is); })) {
+    std::cout  << std::endl;
+    std::cout << "[     case ]: " << pretty(*input) << std::endl;
+    std::cout << "[ premises ]: " << pretty(premises) << std::endl;
+    std::cout << "[ expected ]: " << pretty(expected.unwrap()) << std::endl;
+    exit(-1);
+  }
+}
+
 class Success
 {
   Kernel::Clause* _input;
   Option<ClausePattern> _expected;
+  Kernel::ClauseStack _context;
+  Option<Kernel::ClauseStack> _premises;
 
 public:
   Success() : _input(nullptr) {}
@@ -55,8 +80,21 @@ public:
     return *this;
   }
 
+  Success context(Kernel::ClauseStack x)
+  {
+    _context = x;
+    return *this;
+  }
+
+  Success premises(Kernel::ClauseStack x)
+  {
+    _premises = Option<Kernel::ClauseStack>(x);
+    return *this;
+  }
+
   void run(const SimplificationTester& simpl) {
-    auto res = simpl.simplify(_input);
+    Kernel::ClauseStack premises;
+    auto res = simpl.simplify(_input, _context, premises);
 
     if (!res) {
       std::cout  << std::endl;
@@ -73,6 +111,7 @@ public:
       exit(-1);
 
     }
+    checkPremises(simpl, _input, _premises, premises);
   }
 };
 
@@ -80,6 +119,7 @@ public:
 class NotApplicable
 {
   Kernel::Clause* _input;
+  Kernel::ClauseStack _context;
 public:
   NotApplicable() {}
 
@@ -89,9 +129,15 @@ public:
     return *this;
   }
 
+  NotApplicable context(Kernel::ClauseStack x)
+  {
+    _context = x;
+    return *this;
+  }
 
   void run(const SimplificationTester& simpl) {
-    auto res = simpl.simplify(_input);
+    Kernel::ClauseStack premises;
+    auto res = simpl.simplify(_input, _context, premises);
     if (res != _input ) {
       std::cout  << std::endl;
       std::cout << "[     case ]: " << pretty(*_input) << std::endl;
@@ -102,6 +148,49 @@ public:
   }
 };
 
+/**
+ * The simplification deletes the input as a tautology.
+ */
+class Tautology
+{
+  Kernel::Clause* _input;
+  Kernel::ClauseStack _context;
+  Option<Kernel::ClauseStack> _premises;
+public:
+  Tautology() : _input(nullptr) {}
+
+  Tautology input(Kernel::Clause* x)
+  {
+    _input = x;
+    return *this;
+  }
+
+  Tautology context(Kernel::ClauseStack x)
+  {
+    _context = x;
+    return *this;
+  }
+
+  Tautology premises(Kernel::ClauseStack x)
+  {
+    _premises = Option<Kernel::ClauseStack>(x);
+    return *this;
+  }
+
+  void run(const SimplificationTester& simpl) {
+    Kernel::ClauseStack premises;
+    auto res = simpl.simplify(_input, _context, premises);
+    if (res) {
+      std::cout  << std::endl;
+      std::cout << "[     case ]: " << pretty(*_input) << std::endl;
+      std::cout << "[       is ]: " << pretty(*res) << std::endl;
+      std::cout << "[ expected ]: NULL (indicates the clause is a tautology)" << std::endl;
+      exit(-1);
+    }
+    checkPremises(simpl, _input, _premises, premises);
+  }
+};
+
 #define REGISTER_SIMPL_TESTER(t) using SimplTester = t;
 
 #define TEST_SIMPLIFY(name, ...)                                                                              \
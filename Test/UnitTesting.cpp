@@ -144,7 +144,7 @@ bool TestUnit::runTestsWithNameSubstring(std::string const& pref, ostream& out)
   unsigned cnt_ok  = 0;
   while(uit.hasNext()) {
     TestUnit::Test t=uit.next();
-    if (std::string(t.name).find(pref) != std::string::npos) {
+    if (!t.benchmark && std::string(t.name).find(pref) != std::string::npos) {
       out << "Running " << t.name << "... \r";
       out.flush();
       bool ok;
@@ -171,8 +171,8 @@ bool TestUnit::run(ostream& out)
 void TestUnit::add(Test t)
 { _tests.push(t); }
 
-TestAdder::TestAdder(const char* unitId, TestProc proc, const char* name)
-{ UnitTesting::instance().add(unitId, TestUnit::Test(proc, name)); }
+TestAdder::TestAdder(const char* unitId, TestProc proc, const char* name, bool benchmark)
+{ UnitTesting::instance().add(unitId, TestUnit::Test(proc, name, benchmark)); }
 
 /**
  * Run test in a different process and wait for its termination
@@ -36,10 +36,12 @@ public:
   struct Test
   {
     Test() {}
-    Test(TestProc proc, const char* name) : proc(proc), name(name) {}
+    Test(TestProc proc, const char* name, bool benchmark = false) : proc(proc), name(name), benchmark(benchmark) {}
 
     TestProc proc;
     const char* name;
+    /** benchmarks only run when asked for by their full name, see BENCHMARK_FUN */
+    bool benchmark;
   };
 
 
@@ -98,7 +100,7 @@ std::ostream& operator<<(std::ostream& out, TestUnit::Test const& t);
 class TestAdder
 {
 public:
-  TestAdder(const char* unit, TestProc proc, const char* name);
+  TestAdder(const char* unit, TestProc proc, const char* name, bool benchmark = false);
 };
 
 #define EXPAND(a) a
@@ -112,6 +114,15 @@ public:
     Test::TestAdder __TEST_ADDER(name)(UNIT_ID_STR, __TEST_FN_NAME(name), #name);                             \
     void __TEST_FN_NAME(name)()
 
+/**
+ * A test measuring performance rather than checking correctness. It is not run
+ * with the rest of its unit, only by its full name, e.g. `vtest run KBO kbo_flat_benchmark`.
+ */
+#define BENCHMARK_FUN(name)                                                                                   \
+    void __TEST_FN_NAME(name)();                                                                              \
+    Test::TestAdder __TEST_ADDER(name)(UNIT_ID_STR, __TEST_FN_NAME(name), #name, /* benchmark */ true);       \
+    void __TEST_FN_NAME(name)()
+
 } // namespace Test
 
 int main(int argc, const char** argv);
@@ -0,0 +1,122 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Debug/Assertion.hpp"
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+#include "Test/UnitTesting.hpp"
+
+using namespace Lib;
+
+#ifndef INDIVIDUAL_ALLOCATIONS
+
+TEST_FUN(reclaim_free_blocks)
+{
+  FixedSizeAllocator<24> allocator;
+  Stack<void *> chunks;
+  for(unsigned i = 0; i < 100000; i++) {
+    void *chunk = allocator.alloc();
+    *static_cast<unsigned *>(chunk) = i;
+    chunks.push(chunk);
+  }
+  // nothing free yet
+  ASS_EQ(allocator.reclaim(), 0);
+
+  // free every other chunk: no block becomes empty
+  for(unsigned i = 0; i < chunks.size(); i += 2) {
+    allocator.free(chunks[i]);
+  }
+  ASS_EQ(allocator.reclaim(), 0);
+
+  // free the first half completely
+  for(unsigned i = 1; i < chunks.size() / 2; i += 2) {
+    allocator.free(chunks[i]);
+  }
+  size_t memory = allocator.memory();
+  size_t reclaimed = allocator.reclaim();
+  ASS_G(reclaimed, 0);
+  ASS_EQ(allocator.memory(), memory - reclaimed);
+  // nothing new to reclaim
+  ASS_EQ(allocator.reclaim(), 0);
+
+  // the remaining chunks are untouched
+  for(unsigned i = chunks.size() / 2 + 1; i < chunks.size(); i += 2) {
+    ASS_EQ(*static_cast<unsigned *>(chunks[i]), i);
+  }
+
+  // the free list and the released blocks can be used again
+  for(unsigned i = 0; i < 100000; i++) {
+    void *chunk = allocator.alloc();
+    *static_cast<unsigned *>(chunk) = i;
+  }
+  for(unsigned i = chunks.size() / 2 + 1; i < chunks.size(); i += 2) {
+    ASS_EQ(*static_cast<unsigned *>(chunks[i]), i);
+  }
+}
+
+TEST_FUN(huge_page_arenas)
+{
+  useHugePages(true);
+  FixedSizeAllocator<16> small;
+  FixedSizeAllocator<64> large;
+  Stack<void *> chunks;
+  for(unsigned i = 0; i < 200000; i++) {
+    void *chunk = i % 2 ? small.alloc() : large.alloc();
+    *static_cast<unsigned *>(chunk) = i;
+    chunks.push(chunk);
+  }
+  useHugePages(false);
+
+  for(unsigned i = 0; i < chunks.size(); i++) {
+    ASS_EQ(*static_cast<unsigned *>(chunks[i]), i);
+  }
+  for(unsigned i = 0; i < chunks.size(); i++) {
+    if(i % 2)
+      small.free(chunks[i]);
+    else
+      large.free(chunks[i]);
+  }
+  ASS_G(small.reclaim(), 0);
+  ASS_G(large.reclaim(), 0);
+}
+
+#if ALLOCATOR_TELEMETRY
+struct Counted {
+  USE_ALLOCATOR(Counted);
+  void *payload[3];
+};
+
+TEST_FUN(telemetry_counts_types)
+{
+  const AllocationCounts &counts = AllocationCounts::ofType("Counted");
+  size_t live = counts.live;
+  size_t peak = counts.peak;
+
+  Stack<Counted *> objects;
+  for(unsigned i = 0; i < 100; i++) {
+    objects.push(new Counted());
+  }
+  ASS_EQ(counts.live, live + 100);
+  ASS_EQ(counts.bytes, counts.live * sizeof(Counted));
+  ASS_GE(counts.peak, peak + 100);
+
+  while(objects.isNonEmpty()) {
+    delete objects.pop();
+  }
+  ASS_EQ(counts.live, live);
+  ASS_GE(counts.peak, peak + 100);
+
+  void *known = ALLOC_KNOWN(40, "Counted");
+  ASS_EQ(counts.live, live + 1);
+  DEALLOC_KNOWN(known, 40, "Counted");
+  ASS_EQ(counts.live, live);
+}
+#endif
+
+#endif
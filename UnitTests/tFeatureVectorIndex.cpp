@@ -0,0 +1,134 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+#include "Test/TestUtils.hpp"
+
+#include "Indexing/FeatureVectorIndex.hpp"
+#include "SATSubsumption/SATSubsumptionAndResolution.hpp"
+
+using namespace std;
+using namespace Indexing;
+using namespace Test;
+
+#define MY_SYNTAX_SUGAR \
+  DECL_DEFAULT_VARS \
+  DECL_VAR(x1, 1) \
+  DECL_VAR(x2, 2) \
+  DECL_VAR(x3, 3) \
+  DECL_VAR(x4, 4) \
+  DECL_VAR(y1, 11) \
+  DECL_VAR(y2, 12) \
+  DECL_VAR(y3, 13) \
+  DECL_SORT(s) \
+  DECL_CONST(c, s) \
+  DECL_CONST(d, s) \
+  DECL_CONST(e, s) \
+  DECL_FUNC(f, {s}, s) \
+  DECL_FUNC(f2, {s, s}, s) \
+  DECL_FUNC(g, {s}, s) \
+  DECL_FUNC(g2, {s, s}, s) \
+  DECL_PRED(p, {s}) \
+  DECL_PRED(p2, {s, s}) \
+  DECL_PRED(p3, {s, s, s}) \
+  DECL_PRED(q, {s}) \
+  DECL_PRED(r, {s})
+
+/** exposes the maintenance of the index, which is otherwise driven by a clause container */
+class TestFeatureVectorIndex
+  : public FeatureVectorIndex
+{
+public:
+  void insert(Clause* c) { handleClause(c, true); }
+  void remove(Clause* c) { handleClause(c, false); }
+};
+
+static bool leq(const FeatureVectorIndex::FeatureVector& fv1, const FeatureVectorIndex::FeatureVector& fv2)
+{
+  for (unsigned i = 0; i < FeatureVectorIndex::FEATURES; i++) {
+    if (fv1[i] > fv2[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool contains(ClauseIterator it, Clause* cl)
+{
+  while (it.hasNext()) {
+    if (it.next() == cl) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TEST_FUN(features_of_subsuming_clauses)
+{
+  __ALLOW_UNUSED(MY_SYNTAX_SUGAR)
+
+  vector<pair<Clause*,Clause*>> pairs = {
+    { clause({ p3(x1, x2, x3), p3(f(x2), x4, x4) }),
+      clause({ p3(f(c), d, y1), p3(f(d), c, c), r(x1) }) },
+    { clause({ p(f2(f(g(x1)), x1)), c == g(x1) }),
+      clause({ g(y1) == c, p(f2(f(g(y1)), y1)) }) },
+    { clause({ f2(x1, x2) == c, ~p2(x1, x3), p2(f(f2(x1, x2)), f(x3)) }),
+      clause({ c == f2(x3, y2), ~p2(x3, y1), p2(f(f2(x3, y2)), f(y1)) }) },
+    { clause({ ~p(x1), q(x1) }),
+      clause({ ~p(f(g(c))), q(f(g(c))), r(d) }) },
+  };
+
+  SATSubsumption::SATSubsumptionAndResolution satSubs;
+  for (auto [base, instance] : pairs) {
+    ASS(satSubs.checkSubsumption(base, instance));
+    FeatureVectorIndex::FeatureVector fv1, fv2;
+    FeatureVectorIndex::computeFeatures(base, fv1);
+    FeatureVectorIndex::computeFeatures(instance, fv2);
+    ASS(leq(fv1, fv2));
+  }
+}
+
+TEST_FUN(retrieval)
+{
+  __ALLOW_UNUSED(MY_SYNTAX_SUGAR)
+
+  Clause* general = clause({ p(x1), q(f(x1)) });
+  Clause* instance = clause({ p(c), q(f(c)), r(d) });
+  Clause* deeper = clause({ p(x1), q(f(f(f(f(x1))))) });
+  Clause* negative = clause({ ~p(x1), q(f(x1)) });
+
+  TestFeatureVectorIndex index;
+  index.insert(general);
+  index.insert(instance);
+  index.insert(deeper);
+  index.insert(negative);
+  ASS_EQ(index.size(), 4);
+
+  ASS(contains(index.getSubsumingCandidates(instance), general));
+  ASS(contains(index.getSubsumingCandidates(instance), instance));
+  ASS(!contains(index.getSubsumingCandidates(instance), deeper));
+  ASS(!contains(index.getSubsumingCandidates(instance), negative));
+  ASS(contains(index.getSubsumingCandidates(deeper), general));
+
+  ASS(contains(index.getSubsumedCandidates(general), instance));
+  ASS(contains(index.getSubsumedCandidates(general), deeper));
+  ASS(!contains(index.getSubsumedCandidates(general), negative));
+  ASS(!contains(index.getSubsumedCandidates(deeper), general));
+
+  index.remove(general);
+  index.remove(deeper);
+  ASS_EQ(index.size(), 2);
+  ASS(!contains(index.getSubsumingCandidates(instance), general));
+  ASS(contains(index.getSubsumingCandidates(instance), instance));
+  index.remove(instance);
+  index.remove(negative);
+  ASS_EQ(index.size(), 0);
+  ASS(!index.getSubsumedCandidates(negative).hasNext());
+}
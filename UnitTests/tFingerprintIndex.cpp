@@ -0,0 +1,135 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+#include "Test/TestUtils.hpp"
+
+#include "Indexing/FingerprintIndex.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+using namespace std;
+using namespace Indexing;
+using namespace Test;
+
+#define MY_SYNTAX_SUGAR \
+  DECL_DEFAULT_VARS \
+  DECL_VAR(x1, 1) \
+  DECL_VAR(x2, 2) \
+  DECL_SORT(s) \
+  DECL_CONST(a, s) \
+  DECL_CONST(b, s) \
+  DECL_FUNC(f, {s}, s) \
+  DECL_FUNC(g, {s, s}, s) \
+  DECL_FUNC(h, {s, s, s}, s)
+
+typedef TermWithValue<unsigned> Data;
+
+template<class Iter>
+static Stack<Data> collect(Iter it)
+{
+  auto res = iterTraits(std::move(it))
+    .map([](auto qr) { return *qr.data; })
+    .template collect<Stack>();
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+/** the fingerprint index must retrieve exactly what a substitution tree does */
+static void checkAgainstSubstitutionTree(FingerprintIndex<Data>& index, TermSubstitutionTree<Data>& tree, Stack<TypedTermList> const& queries)
+{
+  for (auto q : queries) {
+    ASS_EQ(collect(index.getUnifications(q, true)), collect(tree.getUnifications(q, true)));
+    ASS_EQ(collect(index.getGeneralizations(q, true)), collect(tree.getGeneralizations(q, true)));
+    ASS_EQ(collect(index.getInstances(q, true)), collect(tree.getInstances(q, true)));
+  }
+}
+
+TEST_FUN(fingerprint_compatibility)
+{
+  __ALLOW_UNUSED(MY_SYNTAX_SUGAR)
+
+  // f(x) and f(a) unify, g(x, y) has no third argument, unlike h(a, b, x)
+  ASS(Fingerprint::mayUnify(Fingerprint(f(x)), Fingerprint(f(a))));
+  ASS(!Fingerprint::mayUnify(Fingerprint(f(a)), Fingerprint(f(b))));
+  ASS(!Fingerprint::mayUnify(Fingerprint(g(x, y)), Fingerprint(h(x, y, z))));
+  ASS(Fingerprint::mayUnify(Fingerprint(x), Fingerprint(g(f(a), b))));
+  ASS(Fingerprint::mayUnify(Fingerprint(g(x, b)), Fingerprint(g(f(a), y))));
+  ASS(!Fingerprint::mayUnify(Fingerprint(g(f(x), b)), Fingerprint(g(a, y))));
+
+  ASS(Fingerprint::mayGeneralize(Fingerprint(f(x)), Fingerprint(f(g(a, b)))));
+  ASS(!Fingerprint::mayGeneralize(Fingerprint(f(a)), Fingerprint(f(x))));
+  ASS(!Fingerprint::mayGeneralize(Fingerprint(f(f(x))), Fingerprint(f(y))));
+  ASS(Fingerprint::mayGeneralize(Fingerprint(g(x, x)), Fingerprint(g(a, f(b)))));
+}
+
+TEST_FUN(retrieval)
+{
+  __ALLOW_UNUSED(MY_SYNTAX_SUGAR)
+
+  Stack<TypedTermList> terms = {
+    a, b, f(a), f(x), f(f(x)), f(f(a)), g(x, y), g(x, x), g(a, f(b)), g(f(x), y),
+    g(f(a), f(b)), h(x, y, z), h(a, b, x), h(f(x), g(y, a), b), TermSugar(x, s),
+  };
+
+  FingerprintIndex<Data> index;
+  TermSubstitutionTree<Data> tree;
+  for (unsigned i = 0; i < terms.size(); i++) {
+    index.insert(Data(terms[i], i));
+    tree.insert(Data(terms[i], i));
+  }
+  // a duplicate shares the fingerprint group of the original
+  index.insert(Data(f(x), 100));
+  tree.insert(Data(f(x), 100));
+
+  Stack<TypedTermList> queries = terms;
+  queries.push(f(b));
+  queries.push(g(y, f(x1)));
+  queries.push(h(x1, x1, x2));
+  checkAgainstSubstitutionTree(index, tree, queries);
+
+  for (unsigned i = 0; i < terms.size(); i += 2) {
+    index.remove(Data(terms[i], i));
+    tree.remove(Data(terms[i], i));
+  }
+  checkAgainstSubstitutionTree(index, tree, queries);
+
+  index.remove(Data(f(x), 100));
+  tree.remove(Data(f(x), 100));
+  for (unsigned i = 1; i < terms.size(); i += 2) {
+    index.remove(Data(terms[i], i));
+  }
+  ASS(!index.getUnifications(TermSugar(x, s), true).hasNext());
+}
+
+TEST_FUN(substitutions)
+{
+  __ALLOW_UNUSED(MY_SYNTAX_SUGAR)
+
+  FingerprintIndex<Data> index;
+  index.insert(Data(g(x, f(y)), 0));
+
+  auto gens = index.getGeneralizations(g(f(a), f(x1)), true);
+  ASS(gens.hasNext());
+  auto gen = gens.next();
+  ASS(gen.unifier->isIdentityOnQueryWhenResultBound());
+  ASS_EQ(gen.unifier->applyToBoundResult(TermList(g(x, f(y)))), TermList(g(f(a), f(x1))));
+  ASS(!gens.hasNext());
+
+  auto insts = index.getInstances(g(x1, x2), true);
+  ASS(insts.hasNext());
+  auto inst = insts.next();
+  ASS(inst.unifier->isIdentityOnResultWhenQueryBound());
+  ASS_EQ(inst.unifier->applyToBoundQuery(TermList(g(x1, x2))), TermList(g(x, f(y))));
+
+  auto unifs = index.getUnifications(g(a, x), true);
+  ASS(unifs.hasNext());
+  auto unif = unifs.next();
+  ASS_EQ(unif.unifier->applyToQuery(TermList(g(a, x))), unif.unifier->applyToResult(TermList(g(x, f(y)))));
+}
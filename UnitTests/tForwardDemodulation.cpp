@@ -0,0 +1,123 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+#include "Test/SimplificationTester.hpp"
+#include "Test/MockedSaturationAlgorithm.hpp"
+
+#include "Inferences/ForwardDemodulation.hpp"
+#include "Indexing/CodeTreeInterfaces.hpp"
+#include "Indexing/TermIndex.hpp"
+#include "Kernel/Problem.hpp"
+#include "Saturation/ClauseContainer.hpp"
+#include "Shell/Options.hpp"
+
+using namespace Kernel;
+using namespace Inferences;
+using namespace Indexing;
+using namespace Saturation;
+using namespace Test;
+
+/**
+ * Rewrites clauses to their normal form (forward_demodulation_normal_form)
+ * with the unit equations of the context as demodulators.
+ */
+class ForwardDemodulationNormalFormTester : public Test::Simplification::SimplificationTester
+{
+public:
+  Clause* simplify(Clause* cl) const override
+  {
+    ClauseStack premises;
+    return simplify(cl, ClauseStack(), premises);
+  }
+
+  Clause* simplify(Clause* cl, const ClauseStack& context, ClauseStack& premises) const override
+  {
+    Problem prb;
+    auto ul = UnitList::empty();
+    UnitList::pushFromIterator(ClauseStack::ConstIterator(context), ul);
+    prb.addUnits(ul);
+    env.setMainProblem(&prb);
+
+    Options opt;
+    opt.set("forward_demodulation_normal_form", "on");
+    MockedSaturationAlgorithm alg(prb, opt);
+
+    // the mocked saturation algorithm has no index manager, so the index is set up here
+    auto container = PlainClauseContainer();
+    DemodulationLHSIndex index(new CodeTreeTIS<DemodulatorData>(), alg.getOrdering(), opt);
+    ForwardDemodulationImpl<false> fd;
+    fd.InferenceEngine::attach(&alg);
+    fd.setTestIndices({ &index });
+    index.attachContainer(&container);
+    for (auto c : context) {
+      c->setStore(Clause::ACTIVE);
+      container.add(c);
+    }
+
+    Clause* res = cl;
+    Clause* replacement = nullptr;
+    ClauseIterator used;
+    if (fd.perform(cl, replacement, used)) {
+      res = replacement;
+      premises.loadFromIterator(used);
+    }
+    fd.InferenceEngine::detach();
+    return res;
+  }
+};
+
+REGISTER_SIMPL_TESTER(ForwardDemodulationNormalFormTester)
+
+#define MY_SYNTAX_SUGAR                                                                   \
+  DECL_DEFAULT_VARS                                                                       \
+  DECL_SORT(s)                                                                            \
+  DECL_FUNC(f, {s}, s)                                                                    \
+  DECL_FUNC(g, {s, s}, s)                                                                 \
+  DECL_FUNC(h, {s}, s)                                                                    \
+  DECL_CONST(a, s)                                                                        \
+  DECL_CONST(b, s)                                                                        \
+  DECL_CONST(c, s)                                                                        \
+  DECL_PRED(p, {s})                                                                       \
+  DECL_PRED(q, {s})                                                                       \
+
+// the normal form takes several rewrites with each demodulator, all of which are premises
+TEST_SIMPLIFY(normal_form_several_steps,
+    Simplification::Success()
+      .context({ clause({ f(f(x)) == x }), clause({ g(x, x) == x }) })
+      .input(    clause({ p(f(f(g(f(f(a)), a)))), q(g(f(f(b)), b)) }))
+      .expected( clause({ p(a), q(b) }))
+      .premises({ clause({ f(f(x)) == x }), clause({ g(x, x) == x }) })
+    )
+
+// rewriting the side of a positive unit equality with a renaming of the demodulator
+// would not make the equality redundant
+TEST_SIMPLIFY(top_level_rewrite_blocked,
+    Simplification::NotApplicable()
+      .context({ clause({ f(f(x)) == x }) })
+      .input(    clause({ f(f(y)) == c }))
+    )
+
+// the strict subterms are still rewritten below the blocked top-level rewrite
+TEST_SIMPLIFY(top_level_rewrite_blocked_after_subterms,
+    Simplification::Success()
+      .context({ clause({ f(f(x)) == x }), clause({ g(x, x) == x }) })
+      .input(    clause({ f(f(g(y, y))) == c }))
+      .expected( clause({ f(f(y)) == c }))
+      .premises({ clause({ g(x, x) == x }) })
+    )
+
+// the rewritten clause is deleted as soon as a literal becomes an equational tautology
+TEST_SIMPLIFY(normal_form_tautology,
+    Simplification::Tautology()
+      .context({ clause({ f(f(x)) == x }), clause({ g(x, x) == x }) })
+      .input(    clause({ p(b), h(f(f(a))) == h(g(a, a)) }))
+      .premises({ clause({ f(f(x)) == x }), clause({ g(x, x) == x }) })
+    )
@@ -8,6 +8,9 @@
  * and in the source directory
  */
 
+#include <chrono>
+#include <random>
+
 #include "Kernel/Term.hpp"
 #include "Kernel/KBO.hpp"
 #include "Kernel/Ordering.hpp"
@@ -586,3 +589,132 @@ TEST_FUN(kbo_isGreater_test17) {
     f(g(y,f(g(x,g(y,z)))))));
 }
 
+
+TEST_FUN(kbo_cache) {
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_FUNC(f, {srt}, srt)
+  DECL_FUNC(g, {srt, srt}, srt)
+  DECL_PRED(p, {srt})
+
+  auto ord = kbo(1, 1, weights(), weights());
+  ord.enableCache(4);
+
+  // repeated and swapped comparisons must agree with the ones computed first
+  for (unsigned i = 0; i < 2; i++) {
+    ASS_EQ(ord.compare(f(g(x,a)), g(x,a)), Ordering::Result::GREATER)
+    ASS_EQ(ord.compare(g(x,a), f(g(x,a))), Ordering::Result::LESS)
+    ASS_EQ(ord.compare(f(x), f(y)), Ordering::Result::INCOMPARABLE)
+    ASS_EQ(ord.compare(p(f(a)), p(a)), Ordering::Result::GREATER)
+    ASS_EQ(ord.compare(p(a), p(f(a))), Ordering::Result::LESS)
+  }
+}
+
+struct ArrayApplicator : public SubstApplicator {
+  ArrayApplicator(std::initializer_list<TermList> values) : values(values) {}
+  TermList operator()(unsigned v) const override { return values[v]; }
+  std::vector<TermList> values;
+};
+
+TEST_FUN(kbo_merged_comparators) {
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_FUNC(f, {srt}, srt)
+  DECL_FUNC(g, {srt, srt}, srt)
+
+  auto ord = kbo(1, 1, weights(), weights());
+
+  // comparators of the same left-hand side sharing the instances of its variables
+  TermList lhs = g(x,y);
+  std::vector<TermList> rhss = { f(f(x)), f(f(y)), g(y,x), f(f(f(f(a)))) };
+  OrderingComparator::SharedSP shared;
+  std::vector<OrderingComparatorUP> comps;
+  for (const auto& rhs : rhss) {
+    comps.push_back(ord.createComparator(lhs, rhs, shared));
+  }
+
+  std::vector<ArrayApplicator> substs = { { a, f(a) }, { f(f(a)), a }, { z, f(z) }, { a, f(a) } };
+  for (const auto& subst : substs) {
+    for (unsigned i = 0; i < rhss.size(); i++) {
+      ASS_EQ(comps[i]->check(&subst),
+        ord.isGreater(AppliedTerm(lhs, &subst, true), AppliedTerm(rhss[i], &subst, true)))
+    }
+  }
+}
+
+// flat comparison tests
+
+/** Random terms over @b f, @b g and the @b leaves, of depth at most @b depth */
+static TermList randomTerm(std::mt19937& random, unsigned depth, const FuncSugar& f, const FuncSugar& g, const Stack<TermList>& leaves)
+{
+  if (depth == 0 || random() % 4 == 0) {
+    return leaves[random() % leaves.size()];
+  }
+  if (random() % 2) {
+    return f(randomTerm(random, depth-1, f, g, leaves), randomTerm(random, depth-1, f, g, leaves));
+  }
+  return g(randomTerm(random, depth-1, f, g, leaves));
+}
+
+static Stack<TermList> randomTerms(unsigned count, unsigned depth)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_CONST(b, srt)
+  DECL_FUNC(f, {srt, srt}, srt)
+  DECL_FUNC(g, {srt}, srt)
+
+  std::mt19937 random(0);
+  Stack<TermList> leaves = { a, b, x, y, z };
+  Stack<TermList> res;
+  for (unsigned i = 0; i < count; i++) {
+    res.push(randomTerm(random, depth, f, g, leaves));
+  }
+  return res;
+}
+
+TEST_FUN(kbo_flat_comparison) {
+  auto terms = randomTerms(200, 4);
+  auto ord = kbo(1, 1, weights(), weights());
+
+  for (unsigned i = 0; i < terms.size(); i++) {
+    for (unsigned j = 0; j < terms.size(); j++) {
+      ord.setFlatComparison(false);
+      auto res = ord.compare(terms[i], terms[j]);
+      ord.setFlatComparison(true);
+      ASS_EQ(ord.compare(terms[i], terms[j]), res)
+    }
+  }
+}
+
+/*
+ * A microbenchmark of the flat comparison against the default one on random terms.
+ * Only meaningful in an optimised build, and not run with the rest of the unit: compile with
+ * the Release flags and call it by its full name, e.g.
+ *   vtest run KBO kbo_flat_benchmark
+ */
+BENCHMARK_FUN(kbo_flat_benchmark) {
+  auto terms = randomTerms(300, 7);
+  auto ord = kbo(1, 1, weights(), weights());
+
+  auto run = [&](bool flat, Stack<Ordering::Result>& results) {
+    ord.setFlatComparison(flat);
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < terms.size(); i++) {
+      for (unsigned j = 0; j < terms.size(); j++) {
+        results.push(ord.compare(terms[i], terms[j]));
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / results.size();
+  };
+  Stack<Ordering::Result> dflt, flat;
+  double dfltTime = run(false, dflt);
+  double flatTime = run(true, flat);
+  ASS(dflt == flat);
+  std::cout << "compared " << dflt.size() << " pairs of terms: "
+            << "default " << dfltTime << "ns, flat " << flatTime << "ns per comparison" << std::endl;
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+#include <cstring>
+
+#include "CASC/PortfolioMode.hpp"
+#include "Kernel/Problem.hpp"
+#include "Lib/Environment.hpp"
+#include "Shell/Options.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+using namespace std;
+using namespace Shell;
+using CASC::PortfolioMode;
+
+/**
+ * All the strategies of CASC/Schedules.cpp, with the function they come from,
+ * extracted by CMake when configuring the build.
+ */
+static const struct {
+  const char* schedule;
+  const char* strategy;
+} STRATEGIES[] = {
+#include "ScheduleStrategies.inc"
+};
+
+/**
+ * The oldest schedules mention many options and values that no longer exist,
+ * the modes using them ignore those (cf. ignore_missing).
+ */
+static bool isLegacy(const char* schedule)
+{
+  static const char* LEGACY[] = {
+    "getCasc2019Schedule",
+    "getCascSat2019Schedule",
+    "getSmtcomp2018Schedule",
+    "getLtb2017Hh4Schedule",
+    "getLtb2017IsaSchedule",
+    "getLtb2017HllSchedule",
+    "getLtb2017MzrSchedule",
+    "getLtb2017DefaultSchedule",
+    "getHigherOrderSchedule2020",
+  };
+  for (const char* legacy : LEGACY) {
+    if (!strcmp(schedule, legacy)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Settings the newer schedules may mention although this build does not know them:
+ * removed options, and those only available with Z3.
+ */
+static bool isTolerated(const string& setting)
+{
+  static const char* TOLERATED[] = {
+    "skr=", "dr=",
+#if !VZ3
+    "thi=", "thitd=", "thigen=", "sffsmt=", "sas=z3",
+#endif
+  };
+  for (const char* tolerated : TOLERATED) {
+    if (!setting.compare(0, strlen(tolerated), tolerated)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// drop the tolerated settings from the options part of @b strategy
+static string withoutTolerated(const string& strategy)
+{
+  size_t begin = strategy.find('_', strategy.find('_') + 1);
+  size_t end = strategy.find_last_of('_');
+  if (begin == string::npos || begin == end) {
+    return strategy;
+  }
+
+  string res = strategy.substr(0, begin + 1);
+  bool first = true;
+  size_t pos = begin + 1;
+  while (pos < end) {
+    size_t next = min(strategy.find(':', pos), end);
+    string setting = strategy.substr(pos, next - pos);
+    if (!isTolerated(setting)) {
+      res += (first ? "" : ":") + setting;
+      first = false;
+    }
+    pos = next + 1;
+  }
+  if (first) {
+    // nothing left
+    res.pop_back();
+  }
+  return res + strategy.substr(end);
+}
+
+/**
+ * Every strategy should be accepted by a slice, cf. PortfolioMode::runSlice.
+ */
+TEST_FUN(all_strategies_valid)
+{
+  Options base;
+  unsigned failures = 0;
+  for (const auto& entry : STRATEGIES) {
+    Options opt = base;
+    bool legacy = isLegacy(entry.schedule);
+    opt.setIgnoreMissing(legacy ? Options::IgnoreMissing::ON : Options::IgnoreMissing::OFF);
+    try {
+      opt.readFromEncodedOptions(legacy ? entry.strategy : withoutTolerated(entry.strategy));
+      opt.setForcedOptionValues();
+      opt.checkGlobalOptionConstraints();
+    }
+    catch (Lib::UserErrorException& e) {
+      cout << entry.schedule << ": " << entry.strategy << endl;
+      e.cry(cout);
+      failures++;
+    }
+  }
+  ASS_EQ(failures, 0);
+}
+
+/**
+ * A slice started from a zygote, which preprocessed the problem for another slice,
+ * runs with the same options as when started directly, cf. PortfolioMode::runZygote.
+ */
+TEST_FUN(zygote_slice_options)
+{
+  // the slices would get random seeds otherwise
+  Lib::env.options->setRandomizeSeedForPortfolioWorkers(false);
+  const string zygoteSlice = "dis+1011_1:1_sos=on:fsr=off:nwc=5.0_10";
+  const string slice = "lrs+10_1:4_avsq=on_20";
+
+  Options direct = PortfolioMode::sliceOptions(*Lib::env.options, slice, 20, 1);
+  Kernel::Problem prb;
+  PortfolioMode::preprocessForSlices(prb, zygoteSlice);
+  Options fromZygote = PortfolioMode::sliceOptions(*Lib::env.options, slice, 20, 1);
+
+  // generateEncodedOptions() remembers the options it skips by their addresses in the first object encoded
+  Options encoder;
+  auto encode = [&](const Options& opt) { encoder = opt; return encoder.generateEncodedOptions(); };
+  ASS_EQ(encode(fromZygote), encode(direct));
+  ASS_EQ(fromZygote.timeLimitInDeciseconds(), direct.timeLimitInDeciseconds());
+  ASS(fromZygote.sos() == Options::Sos::OFF);
+}
@@ -0,0 +1,174 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include <chrono>
+#include <random>
+
+#include "Debug/Assertion.hpp"
+#include "Lib/Set.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/TaggedSet.hpp"
+#include "Test/UnitTesting.hpp"
+#include "UnitTests/dummyHash.hpp"
+
+static int VALUES[100000];
+
+// values are pointers, compared by identity
+struct PointerHash {
+  static unsigned hash(const int* p) { return DefaultHash::hash(reinterpret_cast<uintptr_t>(p)); }
+  static bool equals(const int* p1, const int* p2) { return p1 == p2; }
+};
+
+TEST_FUN(find_remove_contains)
+{
+  TaggedSet<int*, PointerHash> set;
+  int* found = nullptr;
+  set.insert(VALUES + 42);
+  ALWAYS(set.find(VALUES + 42, found));
+  ASS_EQ(found, VALUES + 42);
+  ALWAYS(set.remove(VALUES + 42));
+  found = nullptr;
+  NEVER(set.find(VALUES + 42, found));
+  ASS_EQ(found, nullptr);
+  NEVER(set.contains(VALUES + 42));
+  NEVER(set.remove(VALUES + 42));
+  set.insert(VALUES + 42);
+  ALWAYS(set.contains(VALUES + 42));
+  ASS_EQ(set.size(), 1);
+}
+
+TEST_FUN(dummy_hash)
+{
+  // all values with the same first cell and tag
+  TaggedSet<int*, DummyHash> set;
+  for (int i = 0; i < 100; i++) {
+    set.insert(VALUES + i);
+  }
+  ASS_EQ(set.size(), 100);
+  for (int i = 0; i < 100; i += 2) {
+    ALWAYS(set.remove(VALUES + i));
+  }
+  for (int i = 0; i < 100; i++) {
+    ASS_EQ(set.contains(VALUES + i), i % 2 == 1);
+  }
+}
+
+TEST_FUN(grow_and_iterate)
+{
+  TaggedSet<int*, PointerHash> set;
+  for (unsigned i = 0; i < 50000; i++) {
+    set.insert(VALUES + 2 * i);
+    // also insert and remove, to fill the set with deleted cells
+    set.insert(VALUES + 2 * i + 1);
+    set.remove(VALUES + 2 * i + 1);
+  }
+  ASS_EQ(set.size(), 50000);
+
+  unsigned count = 0;
+  unsigned long sum = 0;
+  auto it = set.iter();
+  while (it.hasNext()) {
+    long i = it.next() - VALUES;
+    ASS_EQ(i % 2, 0);
+    sum += i / 2;
+    count++;
+  }
+  ASS_EQ(count, 50000);
+  ASS_EQ(sum, 49999ul * 50000 / 2);
+}
+
+/*
+ * A microbenchmark replaying a trace of term creations against Set and TaggedSet, as TermSharing does.
+ * Terms are built bottom-up from previously created ones, and about half of the creations
+ * find an existing term, as in saturation.
+ * Only meaningful in an optimised build, and not run with the rest of the unit: compile with
+ * the Release flags and call it by its full name, e.g.
+ *   vtest run TaggedSet replay_term_creation
+ */
+struct FakeTerm {
+  unsigned functor;
+  const FakeTerm* args[2];
+};
+
+struct FakeTermHash {
+  static unsigned hash(const FakeTerm* t)
+  { return hash(t->functor, t->args[0], t->args[1]); }
+  static unsigned hash(unsigned functor, const FakeTerm* arg1, const FakeTerm* arg2)
+  {
+    unsigned res = DefaultHash::hash(functor);
+    res = HashUtils::combine(res, DefaultHash::hash(reinterpret_cast<uintptr_t>(arg1)));
+    return HashUtils::combine(res, DefaultHash::hash(reinterpret_cast<uintptr_t>(arg2)));
+  }
+  static bool equals(const FakeTerm* t1, const FakeTerm* t2)
+  { return t1 == t2; }
+};
+
+// a functor and the indices of its arguments among the terms created before
+struct Creation {
+  unsigned functor;
+  unsigned args[2];
+};
+
+template<class Table>
+static double replay(const Stack<Creation>& trace, unsigned& created)
+{
+  Table table;
+  Stack<FakeTerm*> terms;
+  terms.push(new FakeTerm{0, {nullptr, nullptr}});
+  auto start = std::chrono::steady_clock::now();
+  for (const Creation& creation : trace) {
+    unsigned functor = creation.functor;
+    // the generated trace may count a few creations of existing terms as new
+    const FakeTerm* arg1 = terms[creation.args[0] % terms.size()];
+    const FakeTerm* arg2 = terms[creation.args[1] % terms.size()];
+    bool inserted;
+    FakeTerm* term = table.rawFindOrInsert(
+        [&]() { return new FakeTerm{functor, {arg1, arg2}}; },
+        FakeTermHash::hash(functor, arg1, arg2),
+        [&](const FakeTerm* t) { return t->functor == functor && t->args[0] == arg1 && t->args[1] == arg2; },
+        inserted);
+    if (inserted) {
+      terms.push(term);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  created = terms.size();
+  while (terms.isNonEmpty()) {
+    delete terms.pop();
+  }
+  return std::chrono::duration<double, std::nano>(end - start).count() / trace.size();
+}
+
+BENCHMARK_FUN(replay_term_creation)
+{
+  std::mt19937 random(0);
+  std::geometric_distribution<unsigned> functors(0.2);
+  std::geometric_distribution<unsigned> recent(0.001);
+  Stack<Creation> trace;
+  unsigned terms = 1;
+  for (unsigned i = 0; i < 1000000; i++) {
+    if (i && random() % 2) {
+      // create a term again
+      trace.push(trace[random() % trace.size()]);
+      continue;
+    }
+    // arguments are mostly recent terms, functors few and skewed
+    unsigned arg1 = terms - 1 - recent(random) % terms;
+    unsigned arg2 = terms - 1 - recent(random) % terms;
+    trace.push(Creation{functors(random), {arg1, arg2}});
+    terms++;
+  }
+
+  unsigned createdSet, createdTagged;
+  double set = replay<Set<FakeTerm*, FakeTermHash>>(trace, createdSet);
+  double tagged = replay<TaggedSet<FakeTerm*, FakeTermHash>>(trace, createdTagged);
+  ASS_EQ(createdSet, createdTagged);
+  std::cout << "replayed " << trace.size() << " creations of " << createdSet << " terms: "
+            << "Set " << set << "ns, TaggedSet " << tagged << "ns per creation" << std::endl;
+}
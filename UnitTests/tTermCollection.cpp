@@ -0,0 +1,55 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+#include "Indexing/TermSharing.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+using namespace Test;
+using namespace Indexing;
+
+TEST_FUN(collect_unreachable_terms) {
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_CONST(b, srt)
+  DECL_CONST(c, srt)
+  DECL_FUNC(f, {srt}, srt)
+  DECL_PRED(p, {srt})
+
+  env.sharing->startCollection();
+
+  // kept by an index, both the key and the value
+  TermSubstitutionTree<TermWithValue<Literal*>> tree;
+  tree.insert(TermWithValue<Literal*>(f(f(a)), p(f(b))));
+  // kept by a clause
+  Clause* cl = clause({ p(f(c)) });
+  // garbage: f(f(f(b))) and f(f(b)), but not f(b)
+  f(f(f(b)));
+
+  ASS_EQ(env.sharing->collect(), 2);
+  // nothing more to collect
+  ASS_EQ(env.sharing->collect(), 0);
+
+  // what is kept can still be retrieved
+  unsigned found = 0;
+  for (auto res : iterTraits(tree.getUnifications(f(x), /* retrieveSubstitutions */ true))) {
+    ASS_EQ(res.data->value, p(f(b)));
+    found++;
+  }
+  ASS_EQ(found, 1);
+  ASS_EQ(cl->literals()[0], p(f(c)));
+
+  // once the clause is gone, so are p(f(c)) and f(c), as well as the query f(x)
+  cl->destroy();
+  ASS_EQ(env.sharing->collect(), 3);
+
+  env.sharing->stopCollection();
+}
@@ -13,6 +13,7 @@
 #include "Test/SyntaxSugar.hpp"
 #include "Indexing/TermSubstitutionTree.hpp"
 #include "Indexing/LiteralSubstitutionTree.hpp"
+#include "Indexing/RetrievalCache.hpp"
 
 
 using namespace Test;
@@ -299,3 +300,102 @@ TEST_FUN(zero_arity_predicate) {
 
 }
 
+
+TEST_FUN(batch_01) {
+
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_CONST(b, srt)
+  DECL_FUNC(f, {srt}, srt)
+  DECL_FUNC(g, {srt, srt}, srt)
+
+  TermSubstitutionTree<MyData4> tree;
+  auto dat = [](TypedTermList t,std::string s) { return MyData4(t, std::move(s)); };
+
+  tree.startBatch();
+  tree.insert(dat(f(a), "a"));
+  tree.insert(dat(g(x, b), "b"));
+  tree.insert(dat(f(a), "c"));
+  tree.insert(dat(g(y, b), "d"));
+  tree.insert(dat(f(x), "e"));
+  tree.endBatch();
+
+  check_unify(tree, f(a), { dat(f(a), "a"), dat(f(a), "c"), dat(f(x), "e") });
+  check_unify(tree, g(a, x), { dat(g(x, b), "b"), dat(g(y, b), "d") });
+
+  tree.startBatch();
+  tree.remove(dat(f(a), "a"));
+  tree.remove(dat(g(y, b), "d"));
+  // queries see the postponed updates
+  check_unify(tree, g(a, x), { dat(g(x, b), "b") });
+  tree.remove(dat(f(a), "c"));
+  tree.insert(dat(f(b), "f"));
+  tree.endBatch();
+
+  check_unify(tree, f(x), { dat(f(x), "e"), dat(f(b), "f") });
+  check_unify(tree, g(a, x), { dat(g(x, b), "b") });
+}
+
+TEST_FUN(batch_literal_01) {
+
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_CONST(b, srt)
+  DECL_PRED(p1, {srt})
+  DECL_PRED(q1, {srt})
+
+  using Data = MyData<Literal*>;
+  LiteralSubstitutionTree<Data> tree;
+  auto dat = [](Literal* k,std::string s) { return Data(k, std::move(s)); };
+  tree.insert(dat( p1(a), "1"));
+  tree.insert(dat( p1(b), "2"));
+  tree.insert(dat(~q1(x), "3"));
+
+  tree.startBatch();
+  tree.remove(dat( p1(a), "1"));
+  tree.insert(dat( p1(x), "4"));
+  tree.remove(dat(~q1(x), "3"));
+  tree.insert(dat(~q1(a), "5"));
+  tree.insert(dat(~q1(a), "6"));
+  tree.endBatch();
+
+  check_unify(tree,  p1(a), { dat( p1(x), "4") });
+  check_unify(tree,  p1(x), { dat( p1(b), "2"), dat( p1(x), "4") });
+  check_unify(tree, ~q1(x), { dat(~q1(a), "5"), dat(~q1(a), "6") });
+}
+
+TEST_FUN(empty_retrieval_cache_01) {
+
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_CONST(b, srt)
+  DECL_FUNC(f, {srt}, srt)
+
+  using Data = TermWithValue<unsigned>;
+  TermSubstitutionTree<Data> tree;
+  EmptyRetrievalCache<std::tuple<Term*, unsigned>> cache;
+  unsigned additions = 0;
+  unsigned traversals = 0;
+  auto generalizations = [&](TypedTermList t) {
+    return cache.retrieve<VirtualIterator<QueryRes<ResultSubstitutionSP, Data>>>(additions, std::make_tuple(t.term(), 0u), [&]() {
+      traversals++;
+      return tree.getGeneralizations(t, /* retrieveSubstitutions */ true);
+    });
+  };
+
+  tree.insert(Data(f(a), 0));
+  ASS(generalizations(f(a)).hasNext());
+  ASS(!generalizations(f(b)).hasNext());
+  ASS(!generalizations(f(b)).hasNext());
+  ASS(generalizations(f(a)).hasNext());
+  // only the negative answer is remembered
+  ASS_EQ(traversals, 3);
+
+  tree.insert(Data(f(x), 1));
+  additions++;
+  ASS(generalizations(f(b)).hasNext());
+  ASS_EQ(traversals, 4);
+}
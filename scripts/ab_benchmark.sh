@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# usage:
+# ./ab_benchmark.sh <vampire_exec> <vampire_arguments> <extra_arguments> <problem files ...>
+# runs every problem once with <vampire_arguments> (A) and once with <vampire_arguments> <extra_arguments> (B)
+# and prints the elapsed times, e.g. ./ab_benchmark.sh ./vampire "-t 60" "--huge_pages on" Problems/*.p
+# both argument lists must be passed as one argument each (put into quotation marks)
+
+EXEC_FILE=$1
+EXEC_ARGS="$2"
+EXTRA_ARGS="$3"
+shift 3
+
+elapsed() {
+        $EXEC_FILE $1 $2 2>&1 | grep "Time elapsed" | tail -1 | sed 's/.*: *\([0-9.]*\).*/\1/'
+}
+
+TOTAL_A=0
+TOTAL_B=0
+printf "%-50s %10s %10s\n" problem A B
+for F in $*; do
+        A=$(elapsed "$EXEC_ARGS" $F)
+        B=$(elapsed "$EXEC_ARGS $EXTRA_ARGS" $F)
+        printf "%-50s %10s %10s\n" $F "${A:-?}" "${B:-?}"
+        TOTAL_A=$(echo "$TOTAL_A + ${A:-0}" | bc)
+        TOTAL_B=$(echo "$TOTAL_B + ${B:-0}" | bc)
+done
+printf "%-50s %10s %10s\n" total $TOTAL_A $TOTAL_B
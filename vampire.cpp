@@ -14,6 +14,12 @@
 #include <iostream>
 #include <ostream>
 #include <fstream>
+#include <thread>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #if VZ3
 #include "z3++.h"
@@ -730,6 +736,159 @@ void interactiveMetamode()
   }
 }
 
+// read from @b fd the next job of serverMode, false if there is none
+static bool readJob(int fd, std::string& options, std::string& problem)
+{
+  std::string header;
+  char c;
+  ssize_t res;
+  while ((res = read(fd, &c, 1)) == 1 && c != '\n') {
+    header += c;
+  }
+  if (res != 1) {
+    return false;
+  }
+
+  std::string::size_type end = header.find(' ');
+  unsigned length;
+  if (!Int::stringToUnsignedInt(header.substr(0, end), length)) {
+    return false;
+  }
+  options = end == std::string::npos ? "" : header.substr(end + 1);
+
+  problem.resize(length);
+  for (size_t done = 0; done < length; done += res) {
+    res = read(fd, problem.data() + done, length - done);
+    if (res <= 0) {
+      if (res == -1 && errno == EINTR) {
+        res = 0;
+        continue;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+// run a job of serverMode in a child (whose state is that of the server just after start-up)
+[[noreturn]] static void runJob(const std::string& options, const std::string& problem)
+{
+  Options& opts = *env.options;
+  opts.setServer("");
+
+  Stack<std::string> pieces;
+  pieces.push("vampire");
+  StringUtils::splitStr(options.c_str(),' ',pieces);
+  StringUtils::dropEmpty(pieces);
+  Stack<const char*> argv(pieces.size());
+  for(auto it = pieces.iterFifo(); it.hasNext();) {
+    argv.push(it.next().c_str());
+  }
+  Shell::CommandLine cl(argv.size(), argv.begin());
+  cl.interpret(opts);
+
+  Lib::setMemoryLimit(opts.memoryLimit() * 1048576ul);
+  Lib::useHugePages(opts.hugePages());
+  // only now, as the timer thread reads the time limit from the options we have just set
+  Timer::reinitialise(); // start our timer (in the child)
+
+  if (problem.empty() && !opts.inputFile().empty()) {
+    UIHelper::parseFile(opts.inputFile(),opts.inputSyntax(),true);
+  } else {
+    Options::InputSyntax syntax = opts.inputSyntax();
+    UIHelper::parseSingleLine(problem, syntax == Options::InputSyntax::AUTO ? Options::InputSyntax::TPTP : syntax);
+  }
+  dispatchByMode(UIHelper::getInputProblem());
+  exit(vampireReturnValue);
+}
+
+/**
+ * Solve the jobs (see the server option) coming on standard input, one after another.
+ */
+void serverModeStdin()
+{
+  std::string options, problem;
+  while (readJob(0, options, problem)) {
+    cout.flush();
+    pid_t process = Lib::Sys::Multiprocessing::instance()->fork();
+    ASS_NEQ(process, -1);
+    if (process == 0) {
+      runJob(options, problem);
+    }
+
+    int status;
+    errno = 0;
+    if (waitpid(process, &status, 0) == -1) {
+      SYSTEM_FAIL("Call to waitpid() function failed.", errno);
+    }
+    int code = WIFEXITED(status) ? WEXITSTATUS(status) : VAMP_RESULT_STATUS_OTHER_SIGNAL;
+    cout << "% end of job " << code << endl;
+  }
+}
+
+/**
+ * Solve the jobs (see the server option) coming on the Unix socket @b path,
+ * one per connection, as many in parallel as there are cores (or multicore).
+ */
+void serverModeSocket(const std::string& path)
+{
+  sockaddr_un address;
+  if (path.size() >= sizeof(address.sun_path)) {
+    USER_ERROR("Socket path too long: "+path);
+  }
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, path.c_str());
+
+  errno = 0;
+  int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server == -1) {
+    SYSTEM_FAIL("Call to socket() function failed.", errno);
+  }
+  unlink(path.c_str());
+  if (bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(server, SOMAXCONN) != 0) {
+    SYSTEM_FAIL("Cannot listen on "+path, errno);
+  }
+
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  unsigned maxJobs = env.options->multicore() ? std::min(cores, env.options->multicore()) : cores;
+  unsigned jobs = 0;
+
+  while (true) {
+    // reap the finished jobs, waiting for one if there is no free core
+    int status;
+    pid_t finished;
+    while (jobs && (finished = waitpid(-1, &status, jobs < maxJobs ? WNOHANG : 0)) > 0) {
+      jobs--;
+    }
+
+    int connection = accept(server, nullptr, nullptr);
+    if (connection == -1) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      SYSTEM_FAIL("Call to accept() function failed.", errno);
+    }
+
+    cout.flush();
+    pid_t process = Lib::Sys::Multiprocessing::instance()->fork();
+    ASS_NEQ(process, -1);
+    if (process == 0) {
+      close(server);
+      std::string options, problem;
+      if (!readJob(connection, options, problem)) {
+        exit(VAMP_RESULT_STATUS_UNHANDLED_EXCEPTION);
+      }
+      // all our output goes to the client
+      dup2(connection, STDOUT_FILENO);
+      dup2(connection, STDERR_FILENO);
+      close(connection);
+      runJob(options, problem);
+    }
+    close(connection);
+    jobs++;
+  }
+}
+
 /**
  * The main function.
  * @since 03/12/2003 many changes related to logging
@@ -767,6 +926,7 @@ int main(int argc, char* argv[])
     }
 
     Lib::setMemoryLimit(env.options->memoryLimit() * 1048576ul);
+    Lib::useHugePages(env.options->hugePages());
 
     if (opts.mode() == Options::Mode::MODEL_CHECK) {
       opts.setOutputAxiomNames(true);
@@ -774,6 +934,10 @@ int main(int argc, char* argv[])
 
     if (opts.interactive()) {
       interactiveMetamode();
+    } else if (opts.server() == "-") {
+      serverModeStdin();
+    } else if (!opts.server().empty()) {
+      serverModeSocket(opts.server());
     } else {
       // can only happen after reading options as it relies on `env.options`
       Timer::reinitialise(); // start our timer, so that we also limit parsing